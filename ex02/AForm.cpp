@@ -12,6 +12,7 @@
 
 #include "AForm.hpp"
 #include "Bureaucrat.hpp"
+#include "Trace.hpp"
 
 AForm::AForm(const std::string& name, const std::string& target, int gradeToSign, int gradeToExecute)
 	: name(name), isSigned(false), gradeToSign(gradeToSign), gradeToExecute(gradeToExecute), target(target)
@@ -26,12 +27,12 @@ AForm::AForm(const std::string& name, const std::string& target, int gradeToSign
 
 AForm::AForm(const AForm& other) : name(other.name), isSigned(other.isSigned), gradeToSign(other.gradeToSign), gradeToExecute(other.gradeToExecute), target(other.target)
 {
-	std::cout << "copy constructor is called" << std::endl;
+	TRACE(TRACE_COPIES, "copy constructor is called");
 }
 
 AForm& AForm::operator=(const AForm& other)
 {
-	std::cout << "copy assigment operator called" << std::endl;
+	TRACE(TRACE_COPIES, "copy assigment operator called");
 	if(this != &other)
 	{
 		this->isSigned = other.isSigned;
@@ -41,7 +42,7 @@ AForm& AForm::operator=(const AForm& other)
 
 AForm::~AForm()
 {
-	std::cout << "Form destructor called for " << this->name << std::endl;
+	TRACE(TRACE_LIFECYCLE, "Form destructor called for " << this->name);
 }
 
 const char* AForm::GradeTooHighException::what() const throw()
@@ -12,10 +12,11 @@
 
 
 #include "Bureaucrat.hpp"
+#include "Trace.hpp"
 
 Bureaucrat::Bureaucrat() : name("Default"), grade(150)
 {
-	std::cout << "Default constructor called" << std::endl;
+	TRACE(TRACE_LIFECYCLE, "Default constructor called");
 }
 
 //Parametrized constructor
@@ -32,12 +33,12 @@ Bureaucrat::Bureaucrat(const std::string& name, int grade): name(name)
 
 Bureaucrat::Bureaucrat(const Bureaucrat& other) : name(other.name), grade(other.grade)
 {
-	std::cout << "copy constructor called" << std::endl;
+	TRACE(TRACE_COPIES, "copy constructor called");
 }
 
 Bureaucrat& Bureaucrat::operator=(const Bureaucrat& other)
 {
-	std::cout << "copy assigment operator called" << std::endl;
+	TRACE(TRACE_COPIES, "copy assigment operator called");
 	if(this != &other) //a = a
 	{
 		this->grade = other.grade;
@@ -49,7 +50,7 @@ Bureaucrat& Bureaucrat::operator=(const Bureaucrat& other)
 //A destructor is a special function in a class that is automatically called when an object goes out of scope or is deleted 
 Bureaucrat::~Bureaucrat()
 {
-	std::cout << "Destructor called for " << this->name << std::endl;
+	TRACE(TRACE_LIFECYCLE, "Destructor called for " << this->name);
 }
 
 const char* Bureaucrat::GradeTooHighException::what() const throw()
@@ -12,6 +12,7 @@
 
 #include "AForm.hpp"
 #include "Bureaucrat.hpp"
+#include "Trace.hpp"
 
 AForm::AForm(const std::string& name, const std::string& target, int gradeToSign, int gradeToExecute)
 	: name(name), isSigned(false), gradeToSign(gradeToSign), gradeToExecute(gradeToExecute), target(target)
@@ -24,24 +25,24 @@ AForm::AForm(const std::string& name, const std::string& target, int gradeToSign
 	
 }
 
-AForm::AForm(const AForm& other) : name(other.name), isSigned(other.isSigned), gradeToSign(other.gradeToSign), gradeToExecute(other.gradeToExecute), target(other.target)
+AForm::AForm(const AForm& other) : name(other.name), isSigned(other.isFormSigned()), gradeToSign(other.gradeToSign), gradeToExecute(other.gradeToExecute), target(other.target)
 {
-	std::cout << "copy constructor is called" << std::endl;
+	TRACE(TRACE_COPIES, "copy constructor is called");
 }
 
 AForm& AForm::operator=(const AForm& other)
 {
-	std::cout << "copy assigment operator called" << std::endl;
+	TRACE(TRACE_COPIES, "copy assigment operator called");
 	if(this != &other)
 	{
-		this->isSigned = other.isSigned;
+		__atomic_store_n(&this->isSigned, other.isFormSigned(), __ATOMIC_RELEASE);
 	}
 	return (*this);
 }
 
 AForm::~AForm()
 {
-	std::cout << "Form destructor called for " << this->name << std::endl;
+	TRACE(TRACE_LIFECYCLE, "Form destructor called for " << this->name);
 }
 
 const char* AForm::GradeTooHighException::what() const throw()
@@ -60,14 +61,17 @@ const char*	AForm::FormNotSignedException::what() const throw()
 	return "Form is not signed";
 }
 
-std::string AForm::getName() const
+const std::string& AForm::getName() const
 {
 	return name;
 }
 
+// The signed flag may be set by one thread and read by another: the
+// release store in trySign pairs with this acquire load, so an executor
+// that sees the form signed also sees everything done before signing
 bool  AForm::isFormSigned() const
 {
-	return this->isSigned;
+	return __atomic_load_n(&this->isSigned, __ATOMIC_ACQUIRE);
 }
 
 int	 AForm::getGradeTosign() const
@@ -80,26 +84,79 @@ int  AForm::getGradeToExecute() const
 	return gradeToExecute;
 }
 
-std::string AForm::getTarget() const
+const std::string& AForm::getTarget() const
 {
 	return target;
 }
 
 
-void	AForm::beSigned(const Bureaucrat& bureaucrat)
+FormResult	AForm::trySign(const Bureaucrat& bureaucrat)
 {
 	if(bureaucrat.getGrade() > gradeToSign)
-		throw GradeTooLowException();
-	isSigned = true;
+		return FORM_GRADE_TOO_LOW;
+	__atomic_store_n(&isSigned, true, __ATOMIC_RELEASE);
+	return FORM_OK;
 }
 
-void	AForm::execute(Bureaucrat const &executor) const
+FormResult	AForm::claimSignature(const Bureaucrat& bureaucrat)
+{
+	bool expected = false;
+
+	if(bureaucrat.getGrade() > gradeToSign)
+		return FORM_GRADE_TOO_LOW;
+	if(!__atomic_compare_exchange_n(&isSigned, &expected, true, false,
+			__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+		return FORM_ALREADY_SIGNED;
+	return FORM_OK;
+}
+
+FormResult	AForm::checkExecute(Bureaucrat const &executor) const
 {
 	if(!isFormSigned())
-		throw FormNotSignedException();
+		return FORM_NOT_SIGNED;
 	if(executor.getGrade() > gradeToExecute)
-		throw GradeTooLowException();
-	executeAction();		
+		return FORM_GRADE_TOO_LOW;
+	return FORM_OK;
+}
+
+FormResult	AForm::tryExecute(Bureaucrat const &executor) const
+{
+	FormResult result = checkExecute(executor);
+
+	if(result == FORM_OK)
+		executeAction();
+	return result;
+}
+
+// Turns a failed check into the exception the throwing API has always used
+static void	throwResult(FormResult result)
+{
+	if(result == FORM_GRADE_TOO_LOW)
+		throw AForm::GradeTooLowException();
+	if(result == FORM_NOT_SIGNED)
+		throw AForm::FormNotSignedException();
+}
+
+void	AForm::beSigned(const Bureaucrat& bureaucrat)
+{
+	throwResult(trySign(bureaucrat));
+}
+
+void	AForm::execute(Bureaucrat const &executor) const
+{
+	throwResult(tryExecute(executor));
+}
+
+const char*	AForm::resultMessage(FormResult result)
+{
+	switch (result)
+	{
+		case FORM_GRADE_TOO_LOW:	return GradeTooLowException().what();
+		case FORM_NOT_SIGNED:		return FormNotSignedException().what();
+		case FORM_ALREADY_SIGNED:	return "Form is already signed";
+		case FORM_OK:				break;
+	}
+	return "";
 }
 
 
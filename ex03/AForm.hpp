@@ -19,14 +19,25 @@
 
 class Bureaucrat;
 
+// Outcome of the non-throwing trySign / tryExecute checks
+enum FormResult
+{
+	FORM_OK = 0,
+	FORM_GRADE_TOO_LOW,
+	FORM_NOT_SIGNED,
+	FORM_ALREADY_SIGNED	// claimSignature lost the race to another signer
+};
+
 class AForm
 {
 	private:
 		const std::string 	name;
-		bool 			  	isSigned;
+		bool 			  	isSigned;	// only accessed through __atomic builtins
 		const int 		  	gradeToSign;
 		const int		  	gradeToExecute;
 		std::string			target;
+
+		friend class FormCodec;	// restores isSigned when decoding a snapshot
 		
 	protected:
 		virtual	void executeAction() const = 0;
@@ -37,11 +48,11 @@ class AForm
 		AForm& operator=(const AForm& other);
 		virtual ~AForm();
 
-		std::string getName() const;
+		const std::string& getName() const;
 		bool isFormSigned() const;
 		int  getGradeTosign() const;
 		int  getGradeToExecute() const;
-		std::string	getTarget() const;
+		const std::string& getTarget() const;
 		
 		void	beSigned(const Bureaucrat& bureaucrat);
 		
@@ -64,6 +75,20 @@ class AForm
 		};
 		
 		void	execute(Bureaucrat const &executor) const;
+
+		// Same checks as beSigned / execute, reported instead of thrown.
+		// tryExecute only runs executeAction when it returns FORM_OK;
+		// checkExecute never runs it.
+		FormResult	trySign(const Bureaucrat& bureaucrat);
+		FormResult	tryExecute(Bureaucrat const &executor) const;
+		FormResult	checkExecute(Bureaucrat const &executor) const;
+
+		// Like trySign, but only the first successful signer gets FORM_OK;
+		// everyone after it gets FORM_ALREADY_SIGNED. Safe to race on.
+		FormResult	claimSignature(const Bureaucrat& bureaucrat);
+
+		// The what() text of the exception matching a failed result
+		static const char*	resultMessage(FormResult result);
 };
 
 std::ostream& operator<<(std::ostream& out, const AForm& a);
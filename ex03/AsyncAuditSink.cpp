@@ -0,0 +1,214 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   AsyncAuditSink.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/13 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/13 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "AsyncAuditSink.hpp"
+#include <unistd.h>
+#include <cerrno>
+#include <vector>
+
+AsyncAuditSink::AsyncAuditSink(int fd, size_t capacity)
+	: ring(capacity), fd(fd), started(false), stopping(0), idle(0), waiters(0),
+	  submitted(0), written(0)
+{
+	pthread_mutex_init(&writeLock, NULL);
+	pthread_mutex_init(&sleepLock, NULL);
+	pthread_cond_init(&workReady, NULL);
+	pthread_cond_init(&progress, NULL);
+	started = pthread_create(&writer, NULL, &AsyncAuditSink::writerMain, this) == 0;
+}
+
+AsyncAuditSink::AsyncAuditSink(const AsyncAuditSink& other)
+	: AuditSink(other), ring(1), fd(-1), started(false), stopping(0), idle(0), waiters(0),
+	  submitted(0), written(0)
+{
+	pthread_mutex_init(&writeLock, NULL);
+	pthread_mutex_init(&sleepLock, NULL);
+	pthread_cond_init(&workReady, NULL);
+	pthread_cond_init(&progress, NULL);
+}
+
+AsyncAuditSink& AsyncAuditSink::operator=(const AsyncAuditSink& other)
+{
+	(void)other;
+	return *this;
+}
+
+AsyncAuditSink::~AsyncAuditSink()
+{
+	if (started)
+	{
+		flush();
+		__atomic_store_n(&stopping, 1, __ATOMIC_SEQ_CST);
+		pthread_mutex_lock(&sleepLock);
+		pthread_cond_signal(&workReady);
+		pthread_mutex_unlock(&sleepLock);
+		pthread_join(writer, NULL);
+	}
+	pthread_cond_destroy(&progress);
+	pthread_cond_destroy(&workReady);
+	pthread_mutex_destroy(&sleepLock);
+	pthread_mutex_destroy(&writeLock);
+}
+
+// Each side publishes its own counter or flag, then reads the other's,
+// all seq_cst: either the producer sees idle set and signals under the
+// lock (which the writer holds until it is inside cond_wait), or the
+// writer sees submitted ahead of written and does not sleep. (written
+// can briefly pass submitted: a line is popped before it is counted.)
+void AsyncAuditSink::wakeWriter()
+{
+	if (!__atomic_load_n(&idle, __ATOMIC_SEQ_CST))
+		return;
+	pthread_mutex_lock(&sleepLock);
+	pthread_cond_signal(&workReady);
+	pthread_mutex_unlock(&sleepLock);
+}
+
+// Writer side: sleeps until there is something to write or it must stop.
+// Returns false once stopping.
+bool AsyncAuditSink::waitIdle()
+{
+	pthread_mutex_lock(&sleepLock);
+	__atomic_store_n(&idle, 1, __ATOMIC_SEQ_CST);
+	while (__atomic_load_n(&submitted, __ATOMIC_SEQ_CST) <= written
+		&& !__atomic_load_n(&stopping, __ATOMIC_SEQ_CST))
+		pthread_cond_wait(&workReady, &sleepLock);
+	__atomic_store_n(&idle, 0, __ATOMIC_RELAXED);
+	pthread_mutex_unlock(&sleepLock);
+	return !__atomic_load_n(&stopping, __ATOMIC_ACQUIRE);
+}
+
+// Caller side: until written reaches target. Same publish-then-check
+// handshake as wakeWriter, with waiters and written.
+void AsyncAuditSink::waitForProgress(unsigned long target)
+{
+	pthread_mutex_lock(&sleepLock);
+	__atomic_add_fetch(&waiters, 1, __ATOMIC_SEQ_CST);
+	while (__atomic_load_n(&written, __ATOMIC_SEQ_CST) < target)
+		pthread_cond_wait(&progress, &sleepLock);
+	__atomic_sub_fetch(&waiters, 1, __ATOMIC_RELAXED);
+	pthread_mutex_unlock(&sleepLock);
+}
+
+// Serialized so a long line written directly never splits a chunk
+void AsyncAuditSink::writeAll(const char* data, size_t size)
+{
+	pthread_mutex_lock(&writeLock);
+	while (size > 0)
+	{
+		ssize_t n = ::write(fd, data, size);
+		if (n < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+		data += n;
+		size -= n;
+	}
+	pthread_mutex_unlock(&writeLock);
+}
+
+// Moves everything queued so far into as few write(2) calls as possible
+void AsyncAuditSink::drain(char* buffer)
+{
+	Line line;
+	size_t used = 0;
+	unsigned long count = 0;
+
+	while (ring.tryPop(line))
+	{
+		if (used + line.length + 1 > WRITE_SIZE)
+		{
+			writeAll(buffer, used);
+			used = 0;
+		}
+		for (unsigned int i = 0; i < line.length; i++)
+			buffer[used + i] = line.text[i];
+		used += line.length;
+		buffer[used++] = '\n';
+		count++;
+	}
+	if (used > 0)
+		writeAll(buffer, used);
+	if (count == 0)
+		return;
+	__atomic_add_fetch(&written, count, __ATOMIC_SEQ_CST);
+	if (__atomic_load_n(&waiters, __ATOMIC_SEQ_CST))
+	{
+		pthread_mutex_lock(&sleepLock);
+		pthread_cond_broadcast(&progress);
+		pthread_mutex_unlock(&sleepLock);
+	}
+}
+
+void* AsyncAuditSink::writerMain(void* self)
+{
+	AsyncAuditSink* sink = static_cast<AsyncAuditSink*>(self);
+	std::vector<char> buffer(WRITE_SIZE);
+
+	do
+		sink->drain(&buffer[0]);
+	while (sink->waitIdle());
+	sink->drain(&buffer[0]);
+	return NULL;
+}
+
+void AsyncAuditSink::record(AuditEvent event, const std::string& bureaucrat,
+	const std::string& form, const char* reason)
+{
+	Line line;
+	size_t length = formatLine(line.text, LINE_SIZE, event, bureaucrat, form, reason);
+
+	if (!started)
+	{
+		std::vector<char> text(length + 1);
+		formatLine(&text[0], length, event, bureaucrat, form, reason);
+		text[length] = '\n';
+		writeAll(&text[0], text.size());
+		return;
+	}
+	if (length > LINE_SIZE)
+	{
+		// Too long for a slot: let the ring drain so this thread's lines
+		// stay in order, then write it directly
+		std::vector<char> text(length + 1);
+		formatLine(&text[0], length, event, bureaucrat, form, reason);
+		text[length] = '\n';
+		flush();
+		writeAll(&text[0], text.size());
+		return;
+	}
+	line.length = static_cast<unsigned int>(length);
+	for (;;)
+	{
+		// Read before trying, so a drain that frees room in between counts
+		unsigned long seen = __atomic_load_n(&written, __ATOMIC_SEQ_CST);
+		if (ring.tryPush(line))
+			break;
+		// Ring full: sleep until the writer drains some lines (backpressure)
+		wakeWriter();
+		waitForProgress(seen + 1);
+	}
+	__atomic_add_fetch(&submitted, 1, __ATOMIC_SEQ_CST);
+	wakeWriter();
+}
+
+void AsyncAuditSink::flush()
+{
+	if (!started)
+		return;
+	unsigned long target = __atomic_load_n(&submitted, __ATOMIC_SEQ_CST);
+
+	wakeWriter();
+	waitForProgress(target);
+}
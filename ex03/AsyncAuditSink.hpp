@@ -0,0 +1,74 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   AsyncAuditSink.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/13 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/13 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef ASYNCAUDITSINK_HPP
+#define ASYNCAUDITSINK_HPP
+
+#include <pthread.h>
+#include "AuditSink.hpp"
+#include "LockFreeQueue.hpp"
+
+// Formats each outcome into a slot of a lock-free ring; a background thread
+// drains the ring and writes the lines to a file descriptor in large
+// chunks. Lines are the same as ConsoleAuditSink's, but they are not
+// ordered with anything else written to std::cout.
+// An idle writer sleeps on a condition variable, and so do flush() and a
+// record() that finds the ring full; the mutex is only taken when someone
+// is (or is about to be) asleep. If the writer thread cannot be started,
+// record() writes each line itself.
+class AsyncAuditSink : public AuditSink
+{
+public:
+	static const size_t	LINE_SIZE = 248;		// longer lines skip the ring
+	static const size_t	WRITE_SIZE = 64 * 1024;	// bytes per write(2)
+
+private:
+	struct Line
+	{
+		unsigned int	length;
+		char			text[LINE_SIZE];
+	};
+
+	LockFreeQueue<Line>	ring;
+	int					fd;
+	pthread_t			writer;
+	bool				started;	// false: no writer, record() writes directly
+	int					stopping;
+	int					idle;		// the writer is asleep or about to be
+	int					waiters;	// threads waiting for the writer to make progress
+	unsigned long		submitted;	// lines in the ring (counted after the push)
+	unsigned long		written;	// lines the writer has written out
+	pthread_mutex_t		writeLock;
+	pthread_mutex_t		sleepLock;
+	pthread_cond_t		workReady;	// writer: ring not empty, or stopping
+	pthread_cond_t		progress;	// flush / full ring: the writer drained lines
+
+	AsyncAuditSink(const AsyncAuditSink& other);
+	AsyncAuditSink& operator=(const AsyncAuditSink& other);
+
+	static void*	writerMain(void* self);
+	void			drain(char* buffer);
+	void			writeAll(const char* data, size_t size);
+	void			wakeWriter();
+	bool			waitIdle();
+	void			waitForProgress(unsigned long target);
+
+public:
+	AsyncAuditSink(int fd = 1, size_t capacity = 8192);
+	~AsyncAuditSink();	// flushes and stops the writer
+
+	void	record(AuditEvent event, const std::string& bureaucrat,
+				const std::string& form, const char* reason);
+	void	flush();	// returns once every recorded line has been written
+};
+
+#endif
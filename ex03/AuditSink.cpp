@@ -0,0 +1,93 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   AuditSink.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/13 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/13 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "AuditSink.hpp"
+#include <cstring>
+
+AuditSink::~AuditSink()
+{
+}
+
+void AuditSink::flush()
+{
+}
+
+static size_t append(char* buffer, size_t size, size_t len, const char* str, size_t n)
+{
+	if (len < size)
+		std::memcpy(buffer + len, str, (size - len < n) ? size - len : n);
+	return len + n;
+}
+
+size_t AuditSink::formatLine(char* buffer, size_t size, AuditEvent event,
+	const std::string& bureaucrat, const std::string& form, const char* reason)
+{
+	const char* verb = "";
+	size_t len = 0;
+
+	switch (event)
+	{
+		case AUDIT_SIGNED:			verb = " signed "; break;
+		case AUDIT_SIGN_FAILED:		verb = " couldn’t sign "; break;
+		case AUDIT_EXECUTED:		verb = " executed "; break;
+		case AUDIT_EXECUTE_FAILED:	verb = " couldn't execute "; break;
+	}
+	len = append(buffer, size, len, bureaucrat.data(), bureaucrat.size());
+	len = append(buffer, size, len, verb, std::strlen(verb));
+	len = append(buffer, size, len, form.data(), form.size());
+	if (event == AUDIT_SIGN_FAILED || event == AUDIT_EXECUTE_FAILED)
+	{
+		len = append(buffer, size, len, " because ", 9);
+		len = append(buffer, size, len, reason, std::strlen(reason));
+	}
+	return len;
+}
+
+ConsoleAuditSink::ConsoleAuditSink(std::ostream& out) : out(out)
+{
+}
+
+ConsoleAuditSink::ConsoleAuditSink(const ConsoleAuditSink& other)
+	: AuditSink(other), out(other.out)
+{
+}
+
+ConsoleAuditSink::~ConsoleAuditSink()
+{
+}
+
+void ConsoleAuditSink::record(AuditEvent event, const std::string& bureaucrat,
+	const std::string& form, const char* reason)
+{
+	switch (event)
+	{
+		case AUDIT_SIGNED:
+			out << bureaucrat << " signed " << form << std::endl;
+			break;
+		case AUDIT_SIGN_FAILED:
+			out << bureaucrat << " couldn’t sign " << form
+				<< " because " << reason << std::endl;
+			break;
+		case AUDIT_EXECUTED:
+			out << bureaucrat << " executed " << form << std::endl;
+			break;
+		case AUDIT_EXECUTE_FAILED:
+			out << bureaucrat << " couldn't execute " << form
+				<< " because " << reason << std::endl;
+			break;
+	}
+}
+
+void ConsoleAuditSink::flush()
+{
+	out.flush();
+}
@@ -0,0 +1,63 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   AuditSink.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/13 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/13 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef AUDITSINK_HPP
+#define AUDITSINK_HPP
+
+#include <iostream>
+#include <string>
+#include <cstddef>
+
+enum AuditEvent
+{
+	AUDIT_SIGNED,
+	AUDIT_SIGN_FAILED,
+	AUDIT_EXECUTED,
+	AUDIT_EXECUTE_FAILED
+};
+
+// Receives the outcome of every Bureaucrat::signForm / executeForm.
+// reason is the exception message for the *_FAILED events, NULL otherwise.
+class AuditSink
+{
+public:
+	virtual ~AuditSink();
+
+	virtual void	record(AuditEvent event, const std::string& bureaucrat,
+						const std::string& form, const char* reason) = 0;
+	virtual void	flush();
+
+	// Writes the line signForm/executeForm have always printed, without the
+	// newline. Returns the full length even if it did not fit in size bytes.
+	static size_t	formatLine(char* buffer, size_t size, AuditEvent event,
+						const std::string& bureaucrat, const std::string& form,
+						const char* reason);
+};
+
+// Compatibility mode: prints each outcome to a stream right away, with
+// std::endl, byte for byte what Bureaucrat used to print itself
+class ConsoleAuditSink : public AuditSink
+{
+private:
+	std::ostream&	out;
+
+public:
+	ConsoleAuditSink(std::ostream& out = std::cout);
+	ConsoleAuditSink(const ConsoleAuditSink& other);
+	~ConsoleAuditSink();
+
+	void	record(AuditEvent event, const std::string& bureaucrat,
+				const std::string& form, const char* reason);
+	void	flush();
+};
+
+#endif
@@ -12,10 +12,11 @@
 
 
 #include "Bureaucrat.hpp"
+#include "Trace.hpp"
 
 Bureaucrat::Bureaucrat() : name("Default"), grade(150)
 {
-	std::cout << "Default constructor called" << std::endl;
+	TRACE(TRACE_LIFECYCLE, "Default constructor called");
 }
 
 //Parametrized constructor
@@ -32,12 +33,12 @@ Bureaucrat::Bureaucrat(const std::string& name, int grade): name(name)
 
 Bureaucrat::Bureaucrat(const Bureaucrat& other) : name(other.name), grade(other.grade)
 {
-	std::cout << "copy constructor called" << std::endl;
+	TRACE(TRACE_COPIES, "copy constructor called");
 }
 
 Bureaucrat& Bureaucrat::operator=(const Bureaucrat& other)
 {
-	std::cout << "copy assigment operator called" << std::endl;
+	TRACE(TRACE_COPIES, "copy assigment operator called");
 	if(this != &other) //a = a
 	{
 		this->grade = other.grade;
@@ -49,7 +50,7 @@ Bureaucrat& Bureaucrat::operator=(const Bureaucrat& other)
 //A destructor is a special function in a class that is automatically called when an object goes out of scope or is deleted 
 Bureaucrat::~Bureaucrat()
 {
-	std::cout << "Destructor called for " << this->name << std::endl;
+	TRACE(TRACE_LIFECYCLE, "Destructor called for " << this->name);
 }
 
 const char* Bureaucrat::GradeTooHighException::what() const throw()
@@ -62,7 +63,7 @@ const char* Bureaucrat::GradeTooLowException::what() const throw()
 	return "Grade is too low!";
 }
 
-std::string Bureaucrat::getName() const
+const std::string& Bureaucrat::getName() const
 {
 	return (name);
 }
@@ -72,33 +73,62 @@ int Bureaucrat::getGrade() const
 	return grade;
 }
 
+void Bureaucrat::incrementGrade()
+{
+	if (grade - 1 < 1)
+		throw GradeTooHighException();
+	grade--;
+}
+
+void Bureaucrat::decrementGrade()
+{
+	if (grade + 1 > 150)
+		throw GradeTooLowException();
+	grade++;
+}
+
 std::ostream& operator<<(std::ostream& out, const Bureaucrat& a)
 {
 	out << a.getName() <<", bureaucrat grade " << a.getGrade();
 	return(out);
 }
 
+static ConsoleAuditSink g_consoleAudit;
+
+AuditSink* Bureaucrat::auditSink = &g_consoleAudit;
+
+void Bureaucrat::setAuditSink(AuditSink* sink)
+{
+	auditSink = sink ? sink : &g_consoleAudit;
+}
+
+AuditSink& Bureaucrat::getAuditSink()
+{
+	return *auditSink;
+}
+
 void Bureaucrat::signForm(AForm& form) {
-    try {
-        form.beSigned(*this); // Try to sign the form
-        std::cout << name << " signed " << form.getName() << std::endl;
-    } catch (const std::exception& e) {
-        std::cout << name << " couldn’t sign " << form.getName()
-                  << " because " << e.what() << std::endl;
-    }
+    FormResult result = form.trySign(*this); // No exception on a rejection
+    if (result == FORM_OK)
+        auditSink->record(AUDIT_SIGNED, name, form.getName(), NULL);
+    else
+        auditSink->record(AUDIT_SIGN_FAILED, name, form.getName(), AForm::resultMessage(result));
 }
 
 void	Bureaucrat::executeForm(AForm const& form) const
 {
 	try
 	{
-		form.execute(*this);
-		std::cout << name << " executed " << form.getName() << std::endl;
+		FormResult result = form.tryExecute(*this);
+		if (result == FORM_OK)
+			auditSink->record(AUDIT_EXECUTED, name, form.getName(), NULL);
+		else
+			auditSink->record(AUDIT_EXECUTE_FAILED, name, form.getName(),
+								AForm::resultMessage(result));
 	}
-	catch(const std::exception& e)
+	catch(const std::exception& e) // executeAction itself may still throw
 	{
-		std::cout << name << " couldn't execute " << form.getName()
-					<< " because " << e.what() << std::endl;
+		auditSink->record(AUDIT_EXECUTE_FAILED, name, form.getName(), e.what());
 	}
 		
 }
\ No newline at end of file
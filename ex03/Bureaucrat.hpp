@@ -19,6 +19,7 @@
 #include <exception> // Needed for std::exception
 #include <cstdlib>
 #include "AForm.hpp"
+#include "AuditSink.hpp"
 
 
 class AForm; 
@@ -29,6 +30,8 @@ class Bureaucrat
 		const std::string name;
 		int grade;
 
+		static AuditSink* auditSink; // where signForm/executeForm report
+
 	public:
 		
 		Bureaucrat(); // Default constructor
@@ -38,11 +41,17 @@ class Bureaucrat
 		~Bureaucrat(); // Destructor
 
 		
-		std::string getName() const;
+		const std::string& getName() const;
 		int getGrade() const;
+		void incrementGrade();
+		void decrementGrade();
 		void signForm(AForm& form);
 		void executeForm(AForm const& form) const;
 
+		// NULL restores the default console output
+		static void setAuditSink(AuditSink* sink);
+		static AuditSink& getAuditSink();
+
 		
 		class GradeTooHighException : public std::exception
 		{
@@ -0,0 +1,239 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   DedupShrubberyOutput.cpp                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/29 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/29 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "DedupShrubberyOutput.hpp"
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+#ifdef __linux__
+# include <linux/fs.h>
+#endif
+
+DedupShrubberyOutput::DedupShrubberyOutput(bool allowHardLinks, const std::string& templateName)
+	: templateName(templateName), templateFd(-1)
+{
+	for (int m = 0; m < METHOD_COUNT; m++)
+	{
+		enabled[m] = true;
+		used[m] = 0;
+	}
+	enabled[HARD_LINK] = allowHardLinks;
+	enabled[COPY_RANGE] = false;
+#ifndef FICLONE
+	enabled[CLONE] = false;
+#endif
+}
+
+DedupShrubberyOutput::DedupShrubberyOutput(const DedupShrubberyOutput& other)
+	: ShrubberyOutput(), templateName(other.templateName), templateFd(-1)
+{
+	for (int m = 0; m < METHOD_COUNT; m++)
+	{
+		enabled[m] = other.enabled[m];
+		used[m] = 0;
+	}
+}
+
+DedupShrubberyOutput& DedupShrubberyOutput::operator=(const DedupShrubberyOutput& other)
+{
+	(void)other;
+	return *this;
+}
+
+DedupShrubberyOutput::~DedupShrubberyOutput()
+{
+	if (templateFd >= 0)
+		close(templateFd);
+	if (!templatePath.empty())
+		unlink(templatePath.c_str());
+}
+
+const char* DedupShrubberyOutput::name() const
+{
+	return "dedup";
+}
+
+size_t DedupShrubberyOutput::count(Method method) const
+{
+	return used[method];
+}
+
+bool DedupShrubberyOutput::isEnabled(Method method) const
+{
+	return enabled[method];
+}
+
+void DedupShrubberyOutput::enable(Method method)
+{
+#ifndef FICLONE
+	if (method == CLONE)
+		return;
+#endif
+#ifndef __linux__
+	if (method == COPY_RANGE)
+		return;
+#endif
+	enabled[method] = true;
+}
+
+void DedupShrubberyOutput::disable(Method method)
+{
+	if (method != WRITE)
+		enabled[method] = false;
+}
+
+const char* DedupShrubberyOutput::methodName(Method method)
+{
+	static const char* names[METHOD_COUNT] = { "hard link", "clone", "copy_file_range", "write" };
+
+	return names[method];
+}
+
+// Errors that say "this filesystem or kernel cannot", as opposed to a
+// problem with one particular file
+void DedupShrubberyOutput::disableIfUnsupported(Method method, int error)
+{
+	if (error == EXDEV || error == EOPNOTSUPP || error == ENOTTY || error == ENOSYS
+		|| error == EINVAL || error == EPERM)
+		disable(method);
+}
+
+// Written once, in the directory of the first target so that links and
+// clones stay on one filesystem
+bool DedupShrubberyOutput::prepareTemplate(const std::string& firstPath)
+{
+	if (templateFd >= 0)
+		return true;
+
+	size_t slash = firstPath.rfind('/');
+	std::string path = slash == std::string::npos ? templateName
+		: firstPath.substr(0, slash + 1) + templateName;
+	// A fresh inode, never one a previous run linked targets to
+	unlink(path.c_str());
+	if (!ShrubberyCreationForm::writeArt(path.c_str()))
+		return false;
+	templateFd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (templateFd < 0)
+	{
+		unlink(path.c_str());
+		return false;
+	}
+	templatePath = path;
+	return true;
+}
+
+static int writeAt(int fd, const char* data, size_t size)
+{
+	size_t done = 0;
+
+	while (done < size)
+	{
+		ssize_t n = pwrite(fd, data + done, size - done, done);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return n < 0 ? errno : EIO;
+		done += n;
+	}
+	return 0;
+}
+
+// 0, or the errno of the last method tried
+int DedupShrubberyOutput::materialize(const char* path)
+{
+	size_t size = ShrubberyCreationForm::getArtSize();
+
+	if (enabled[HARD_LINK])
+	{
+		if (unlink(path) != 0 && errno != ENOENT)
+			return errno;
+		if (link(templatePath.c_str(), path) == 0)
+		{
+			used[HARD_LINK]++;
+			return 0;
+		}
+		disableIfUnsupported(HARD_LINK, errno);
+	}
+
+	int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0)
+		return errno;
+
+	int error = 0;
+	Method method = WRITE;
+#ifdef FICLONE
+	if (enabled[CLONE])
+	{
+		if (ioctl(fd, FICLONE, templateFd) == 0)
+			method = CLONE;
+		else
+			disableIfUnsupported(CLONE, errno);
+	}
+#endif
+#ifdef __linux__
+	if (method == WRITE && enabled[COPY_RANGE])
+	{
+		loff_t from = 0;
+		size_t done = 0;
+		int copyError = 0;
+		while (done < size)
+		{
+			ssize_t n = copy_file_range(templateFd, &from, fd, NULL, size - done, 0);
+			if (n < 0 && errno == EINTR)
+				continue;
+			if (n < 0)
+				copyError = errno;
+			if (n <= 0)
+				break;
+			done += n;
+		}
+		if (done == size)
+			method = COPY_RANGE;
+		else
+		{
+			// A short copy (n == 0) is this file's problem: plain write,
+			// and copy_file_range stays enabled for the next one
+			if (copyError != 0)
+				disableIfUnsupported(COPY_RANGE, copyError);
+			if (done > 0 && ftruncate(fd, 0) != 0)
+				error = errno;
+		}
+	}
+#endif
+	if (method == WRITE && error == 0)
+		error = writeAt(fd, ShrubberyCreationForm::getArt(), size);
+	if (close(fd) != 0 && error == 0)
+		error = errno;
+	if (error == 0)
+		used[method]++;
+	return error;
+}
+
+void DedupShrubberyOutput::writeAll(const std::vector<std::string>& paths, std::vector<int>& errors)
+{
+	errors.assign(paths.size(), 0);
+	if (paths.empty())
+		return;
+	// No template, no dedup: every file gets the plain write
+	if (!prepareTemplate(paths[0]))
+		for (int m = 0; m < WRITE; m++)
+			enabled[m] = false;
+	for (size_t i = 0; i < paths.size(); i++)
+	{
+		if (templateFd < 0)
+			errors[i] = ShrubberyCreationForm::writeArt(paths[i].c_str()) ? 0 : errno;
+		else
+			errors[i] = materialize(paths[i].c_str());
+	}
+}
@@ -0,0 +1,79 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   DedupShrubberyOutput.hpp                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/29 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/29 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef DEDUPSHRUBBERYOUTPUT_HPP
+#define DEDUPSHRUBBERYOUTPUT_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "ShrubberyOutput.hpp"
+
+// Every shrubbery file holds the same bytes, so this backend writes them
+// once to a template file and makes each target from it:
+//   HARD_LINK   link(2) to the template: no data, no new inode
+//   CLONE       FICLONE ioctl: shares the template's extents (btrfs, xfs)
+//   COPY_RANGE  copy_file_range(2): the copy stays in the kernel
+//   WRITE       plain write of the art, always works
+// Each file tries the enabled methods in that order and drops to the next
+// one on failure; a method the filesystem does not support (EXDEV,
+// EOPNOTSUPP, ...) is not tried again. Clone and write are on by default.
+// Hard links are opt-in: the targets then share one inode, and rewriting
+// any of them in place (writeArt opens with O_TRUNC) changes all of them.
+// copy_file_range is opt-in too: where it does not reflink (tmpfs, ext4)
+// it uses as much space as a write and is much slower on ext4, so it only
+// pays off on filesystems that copy server-side (NFS, SMB).
+// The template lives next to the first target (templateName in the same
+// directory) and is removed with the output.
+class DedupShrubberyOutput : public ShrubberyOutput
+{
+public:
+	enum Method
+	{
+		HARD_LINK,
+		CLONE,
+		COPY_RANGE,
+		WRITE,
+		METHOD_COUNT
+	};
+
+private:
+	std::string	templateName;
+	std::string	templatePath;	// set once written
+	int			templateFd;
+	bool		enabled[METHOD_COUNT];
+	size_t		used[METHOD_COUNT];
+
+	DedupShrubberyOutput(const DedupShrubberyOutput& other);
+	DedupShrubberyOutput& operator=(const DedupShrubberyOutput& other);
+
+	bool	prepareTemplate(const std::string& firstPath);
+	int		materialize(const char* path);
+	void	disableIfUnsupported(Method method, int error);
+
+public:
+	DedupShrubberyOutput(bool allowHardLinks = false,
+		const std::string& templateName = ".shrubbery_template");
+	~DedupShrubberyOutput();
+
+	void		writeAll(const std::vector<std::string>& paths, std::vector<int>& errors);
+	const char*	name() const;
+
+	size_t		count(Method method) const;	// files made with each method so far
+	bool		isEnabled(Method method) const;
+	void		enable(Method method);
+	void		disable(Method method);		// WRITE cannot be disabled
+
+	static const char*	methodName(Method method);
+};
+
+#endif
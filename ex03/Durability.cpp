@@ -0,0 +1,263 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Durability.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/30 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/30 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Durability.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <ctime>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+
+static DurabilityPolicy	g_durability = { DURABILITY_NONE, 64, 5 };
+
+void setDurability(DurabilityMode mode, size_t groupFiles, unsigned int groupMs)
+{
+	g_durability.mode = mode;
+	g_durability.groupFiles = groupFiles ? groupFiles : 1;
+	g_durability.groupMs = groupMs;
+}
+
+DurabilityPolicy getDurability()
+{
+	return g_durability;
+}
+
+const char* durabilityName(DurabilityMode mode)
+{
+	static const char* names[3] = { "none", "fsync", "group commit" };
+
+	return names[mode];
+}
+
+static std::string directoryOf(const std::string& path)
+{
+	size_t slash = path.rfind('/');
+
+	if (slash == std::string::npos)
+		return ".";
+	if (slash == 0)
+		return "/";
+	return path.substr(0, slash);
+}
+
+// fsync of the directory alone, or with whole the filesystem it is on
+// (syncfs: every dirty file and entry, in one journal commit)
+static int syncDirectoryFd(int fd, bool whole)
+{
+	int result;
+#ifdef __linux__
+	result = whole ? syncfs(fd) : fsync(fd);
+#else
+	if (whole)
+		sync();
+	result = fsync(fd);
+#endif
+	return result == 0 ? 0 : errno;
+}
+
+static int syncDirectory(const std::string& dir, bool whole)
+{
+	int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+	if (fd < 0)
+		return errno;
+	int error = syncDirectoryFd(fd, whole);
+	close(fd);
+	return error;
+}
+
+/* ------------------------------------------------------------------------ */
+/*  Group commit                                                             */
+/* ------------------------------------------------------------------------ */
+
+// One commit's worth of files. The thread that finds it full or late
+// takes it out of g_open and syncs it; the others sleep until done.
+struct Group
+{
+	std::vector<std::string>	dirs;
+	std::vector<int>			dirFds;	// held open by the members' callers
+	size_t						members;
+	size_t						waiters;
+	struct timespec				deadline;
+	bool						done;
+	int							error;
+};
+
+static pthread_mutex_t	g_groupLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t	g_groupDone = PTHREAD_COND_INITIALIZER;
+static Group*			g_open = NULL;		// the group new files join
+static bool				g_committing = false;	// one sync at a time
+
+static int syncGroup(const Group& group)
+{
+	int error = 0;
+
+	for (size_t i = 0; i < group.dirs.size(); i++)
+	{
+		int result = syncDirectory(group.dirs[i], true);
+		if (error == 0)
+			error = result;
+	}
+	for (size_t i = 0; i < group.dirFds.size(); i++)
+	{
+		int result = syncDirectoryFd(group.dirFds[i], true);
+		if (error == 0)
+			error = result;
+	}
+	return error;
+}
+
+static bool passed(const struct timespec& deadline)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_REALTIME, &now);
+	return now.tv_sec > deadline.tv_sec
+		|| (now.tv_sec == deadline.tv_sec && now.tv_nsec >= deadline.tv_nsec);
+}
+
+// The file's directory by path, or by an open fd when dir is NULL
+static int joinGroup(const std::string* dir, int dirFd)
+{
+	pthread_mutex_lock(&g_groupLock);
+	if (g_open == NULL)
+	{
+		g_open = new Group();
+		g_open->members = 0;
+		g_open->waiters = 0;
+		g_open->done = false;
+		g_open->error = 0;
+		clock_gettime(CLOCK_REALTIME, &g_open->deadline);
+		unsigned long long ns = g_open->deadline.tv_nsec
+			+ static_cast<unsigned long long>(g_durability.groupMs) * 1000000ULL;
+		g_open->deadline.tv_sec += ns / 1000000000ULL;
+		g_open->deadline.tv_nsec = ns % 1000000000ULL;
+	}
+	Group* group = g_open;
+	if (dir == NULL)
+	{
+		if (std::find(group->dirFds.begin(), group->dirFds.end(), dirFd) == group->dirFds.end())
+			group->dirFds.push_back(dirFd);
+	}
+	else if (std::find(group->dirs.begin(), group->dirs.end(), *dir) == group->dirs.end())
+		group->dirs.push_back(*dir);
+	group->members++;
+	group->waiters++;
+
+	while (!group->done)
+	{
+		bool ready = group == g_open
+			&& (group->members >= g_durability.groupFiles || passed(group->deadline));
+		if (ready && !g_committing)
+		{
+			g_open = NULL;
+			g_committing = true;
+			pthread_mutex_unlock(&g_groupLock);
+			int error = syncGroup(*group);
+			pthread_mutex_lock(&g_groupLock);
+			group->error = error;
+			group->done = true;
+			g_committing = false;
+			pthread_cond_broadcast(&g_groupDone);
+		}
+		else if (ready || group != g_open)
+			pthread_cond_wait(&g_groupDone, &g_groupLock);
+		else
+			pthread_cond_timedwait(&g_groupDone, &g_groupLock, &group->deadline);
+	}
+
+	int error = group->error;
+	if (--group->waiters == 0)
+		delete group;
+	pthread_mutex_unlock(&g_groupLock);
+	return error;
+}
+
+/* ------------------------------------------------------------------------ */
+/*  Entry points                                                             */
+/* ------------------------------------------------------------------------ */
+
+int closeDurably(int fd, const char* path)
+{
+	DurabilityMode mode = g_durability.mode;
+	int error = 0;
+
+	if (mode == DURABILITY_FSYNC && fsync(fd) != 0)
+		error = errno;
+	if (close(fd) != 0 && error == 0)
+		error = errno;
+	if (error != 0 || mode == DURABILITY_NONE)
+		return error;
+	std::string dir = directoryOf(path);
+	if (mode == DURABILITY_FSYNC)
+		return syncDirectory(dir, false);
+	return joinGroup(&dir, -1);
+}
+
+int closeDurablyAt(int fd, int dirFd)
+{
+	DurabilityMode mode = g_durability.mode;
+	int error = 0;
+
+	if (mode == DURABILITY_FSYNC && fsync(fd) != 0)
+		error = errno;
+	if (close(fd) != 0 && error == 0)
+		error = errno;
+	if (error != 0 || mode == DURABILITY_NONE)
+		return error;
+	if (mode == DURABILITY_FSYNC)
+		return syncDirectoryFd(dirFd, false);
+	return joinGroup(NULL, dirFd);
+}
+
+void syncFiles(const std::vector<std::string>& paths, std::vector<int>& errors)
+{
+	DurabilityMode mode = g_durability.mode;
+	std::vector<std::string> dirs;
+
+	if (mode == DURABILITY_NONE)
+		return;
+	for (size_t i = 0; i < paths.size(); i++)
+	{
+		if (errors[i] != 0)
+			continue;
+		if (mode == DURABILITY_FSYNC)
+		{
+			int fd = open(paths[i].c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd < 0)
+			{
+				errors[i] = errno;
+				continue;
+			}
+			if (fsync(fd) != 0)
+				errors[i] = errno;
+			close(fd);
+			if (errors[i] != 0)
+				continue;
+		}
+		std::string dir = directoryOf(paths[i]);
+		if (std::find(dirs.begin(), dirs.end(), dir) == dirs.end())
+			dirs.push_back(dir);
+	}
+
+	// Every file of a directory depends on that directory's sync
+	for (size_t d = 0; d < dirs.size(); d++)
+	{
+		int error = syncDirectory(dirs[d], mode == DURABILITY_GROUP);
+		if (error == 0)
+			continue;
+		for (size_t i = 0; i < paths.size(); i++)
+			if (errors[i] == 0 && directoryOf(paths[i]) == dirs[d])
+				errors[i] = error;
+	}
+}
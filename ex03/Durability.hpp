@@ -0,0 +1,63 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Durability.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/30 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/30 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef DURABILITY_HPP
+#define DURABILITY_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// How much a written output file must survive before its form reports
+// success:
+//   NONE   the data is in the page cache (what close() gives)
+//   FSYNC  fsync of the file, then of its directory, for every file
+//   GROUP  files wait to be committed together: once groupFiles are
+//          waiting, or the oldest has waited groupMs, one thread syncs
+//          their directories' filesystems (syncfs, which covers the data
+//          and the new directory entries) and wakes the whole group
+// GROUP only pays off when several threads execute forms at once; a
+// lone thread waits groupMs for every file.
+enum DurabilityMode
+{
+	DURABILITY_NONE,
+	DURABILITY_FSYNC,
+	DURABILITY_GROUP
+};
+
+struct DurabilityPolicy
+{
+	DurabilityMode	mode;
+	size_t			groupFiles;
+	unsigned int	groupMs;
+};
+
+// Process-wide, NONE by default. Set it before forms start writing.
+void				setDurability(DurabilityMode mode, size_t groupFiles = 64,
+						unsigned int groupMs = 5);
+DurabilityPolicy	getDurability();
+const char*			durabilityName(DurabilityMode mode);
+
+// Closes a file just written to path, returning once the policy is met;
+// 0 or the errno that broke it
+int		closeDurably(int fd, const char* path);
+
+// Same, with the file's directory already open as dirFd: nothing is
+// looked up by path. dirFd must stay open until this returns.
+int		closeDurablyAt(int fd, int dirFd);
+
+// Same for files already written and closed: each path whose errors[i]
+// is 0 is made durable, and gets the errno if that fails. A GROUP batch
+// is one group, committed at once.
+void	syncFiles(const std::vector<std::string>& paths, std::vector<int>& errors);
+
+#endif
@@ -0,0 +1,91 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FormArena.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/10 14:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/10 14:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "FormArena.hpp"
+#include "ShrubberyCreationForm.hpp"
+#include "RobotomyRequestForm.hpp"
+#include "PresidentialPardonForm.hpp"
+
+#define MAX_SIZE(a, b)	(sizeof(a) > sizeof(b) ? sizeof(a) : sizeof(b))
+#define LARGEST_FORM	(MAX_SIZE(ShrubberyCreationForm, RobotomyRequestForm) > sizeof(PresidentialPardonForm) \
+						? MAX_SIZE(ShrubberyCreationForm, RobotomyRequestForm) : sizeof(PresidentialPardonForm))
+
+// Rounded up to 16 so every slot is aligned for any member type
+const size_t FormArena::SLOT_SIZE = (LARGEST_FORM + 15) & ~static_cast<size_t>(15);
+
+FormArena::FormArena(size_t capacity)
+	: slab(new char[capacity * SLOT_SIZE]), capacity(capacity)
+{
+	forms.reserve(capacity);
+}
+
+FormArena::FormArena(const FormArena& other) : slab(NULL), capacity(0)
+{
+	(void)other;
+}
+
+FormArena& FormArena::operator=(const FormArena& other)
+{
+	(void)other;
+	return *this;
+}
+
+FormArena::~FormArena()
+{
+	clear();
+	delete[] slab;
+}
+
+AForm* FormArena::create(const FormType& type, const std::string& target)
+{
+	if (forms.size() == capacity || type.place == NULL || type.size > SLOT_SIZE)
+		return NULL;
+
+	AForm* form = type.place(slab + forms.size() * SLOT_SIZE, target);
+	forms.push_back(form);
+	return form;
+}
+
+void FormArena::clear()
+{
+	for (size_t i = forms.size(); i > 0; i--)
+		forms[i - 1]->~AForm();
+	forms.clear();
+}
+
+void FormArena::reset(size_t capacity)
+{
+	clear();
+	if (capacity > this->capacity)
+	{
+		char* bigger = new char[capacity * SLOT_SIZE];
+		delete[] slab;
+		slab = bigger;
+		this->capacity = capacity;
+		forms.reserve(capacity);
+	}
+}
+
+size_t FormArena::size() const
+{
+	return forms.size();
+}
+
+size_t FormArena::getCapacity() const
+{
+	return capacity;
+}
+
+AForm* FormArena::operator[](size_t index) const
+{
+	return forms[index];
+}
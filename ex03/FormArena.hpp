@@ -0,0 +1,53 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FormArena.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/10 14:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/10 14:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef FORMARENA_HPP
+#define FORMARENA_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "AForm.hpp"
+#include "FormRegistry.hpp"
+
+// A slab of fixed-size slots, each big enough for any of the standard
+// forms. Forms are placement-constructed into the next free slot and
+// all of them are destroyed together by clear() or the destructor, so a
+// batch costs one allocation instead of one new/delete per form.
+class FormArena
+{
+private:
+	char*				slab;
+	size_t				capacity;
+	std::vector<AForm*>	forms;
+
+	// Not copyable: the forms live inside the slab
+	FormArena(const FormArena& other);
+	FormArena& operator=(const FormArena& other);
+
+public:
+	static const size_t	SLOT_SIZE;
+
+	FormArena(size_t capacity);
+	~FormArena();
+
+	// NULL if the arena is full or the form type cannot be placed here
+	AForm*	create(const FormType& type, const std::string& target);
+	void	clear();
+	void	reset(size_t capacity);	// clear, then make room for capacity forms
+
+	size_t	size() const;
+	size_t	getCapacity() const;
+	AForm*	operator[](size_t index) const;
+};
+
+#endif
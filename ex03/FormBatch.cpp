@@ -0,0 +1,89 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FormBatch.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/11 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/11 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "FormBatch.hpp"
+
+FormBatch::FormBatch() : arena(0)
+{
+}
+
+FormBatch::FormBatch(const FormBatch& other) : arena(0)
+{
+	(void)other;
+}
+
+FormBatch& FormBatch::operator=(const FormBatch& other)
+{
+	(void)other;
+	return *this;
+}
+
+FormBatch::~FormBatch()
+{
+}
+
+void FormBatch::clear()
+{
+	arena.clear();
+	statuses.clear();
+	positions.clear();
+	groups.clear();
+}
+
+size_t FormBatch::size() const
+{
+	return arena.size();
+}
+
+AForm* FormBatch::operator[](size_t index) const
+{
+	return arena[index];
+}
+
+size_t FormBatch::requestCount() const
+{
+	return statuses.size();
+}
+
+FormBatch::Status FormBatch::status(size_t request) const
+{
+	return statuses[request];
+}
+
+AForm* FormBatch::formFor(size_t request) const
+{
+	if (statuses[request] != CREATED)
+		return NULL;
+	return arena[positions[request]];
+}
+
+size_t FormBatch::groupCount() const
+{
+	return groups.size();
+}
+
+const FormBatch::Group& FormBatch::group(size_t index) const
+{
+	return groups[index];
+}
+
+const char* FormBatch::statusName(Status status)
+{
+	switch (status)
+	{
+		case CREATED:		return "created";
+		case UNKNOWN_FORM:	return "unknown form";
+		case NOT_PLACEABLE:	return "form cannot be batched";
+		case FAILED:		return "form constructor failed";
+	}
+	return "unknown status";
+}
@@ -0,0 +1,82 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FormBatch.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/11 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/11 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef FORMBATCH_HPP
+#define FORMBATCH_HPP
+
+#include <string>
+#include <vector>
+#include "AForm.hpp"
+#include "FormArena.hpp"
+
+// One (formName, target) pair handed to Intern::makeForms
+struct FormRequest
+{
+	std::string	formName;
+	std::string	target;
+};
+
+// Forms built by Intern::makeForms. They sit next to each other in one
+// arena, grouped by concrete type, so later passes can walk each group
+// linearly. The outcome of every request is kept by its position.
+class FormBatch
+{
+public:
+	enum Status
+	{
+		CREATED,
+		UNKNOWN_FORM,	// name not in the registry
+		NOT_PLACEABLE,	// registered without a placement creator
+		FAILED			// the form constructor threw
+	};
+
+	// forms [begin, end) all have the same type
+	struct Group
+	{
+		std::string	formName;
+		size_t		begin;
+		size_t		end;
+	};
+
+private:
+	FormArena			arena;
+	std::vector<Status>	statuses;
+	std::vector<size_t>	positions;	// request -> index in arena
+	std::vector<Group>	groups;
+
+	FormBatch(const FormBatch& other);
+	FormBatch& operator=(const FormBatch& other);
+
+	friend class Intern;
+
+public:
+	FormBatch();
+	~FormBatch();
+
+	void	clear();
+
+	// Created forms, in grouped order
+	size_t	size() const;
+	AForm*	operator[](size_t index) const;
+
+	// Per request, in the order they were given
+	size_t	requestCount() const;
+	Status	status(size_t request) const;
+	AForm*	formFor(size_t request) const;	// NULL unless CREATED
+
+	size_t			groupCount() const;
+	const Group&	group(size_t index) const;
+
+	static const char*	statusName(Status status);
+};
+
+#endif
@@ -0,0 +1,290 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FormCodec.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/12/02 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/12/02 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "FormCodec.hpp"
+#include "ShrubberyCreationForm.hpp"
+#include "RobotomyRequestForm.hpp"
+#include "PresidentialPardonForm.hpp"
+#include <cstring>
+
+// Grades of each form type, indexed by TypeId
+struct FormKind
+{
+	int			gradeToSign;
+	int			gradeToExecute;
+};
+
+static const FormKind	g_kinds[4] = {
+	{ 0, 0 },
+	{ 145, 137 },	// Shrubbery Creation
+	{ 72, 45 },		// Robotomy Request
+	{ 25, 5 }		// Presidential Pardon
+};
+
+FormCodec::FormCodec() : slots(16, -1), mask(15)
+{
+}
+
+FormCodec::FormCodec(const FormCodec& other)
+	: strings(other.strings), hashes(other.hashes), slots(other.slots), mask(other.mask)
+{
+}
+
+FormCodec& FormCodec::operator=(const FormCodec& other)
+{
+	if (this != &other)
+	{
+		strings = other.strings;
+		hashes = other.hashes;
+		slots = other.slots;
+		mask = other.mask;
+	}
+	return *this;
+}
+
+FormCodec::~FormCodec()
+{
+}
+
+/* ------------------------------------------------------------------------ */
+/*  String table                                                             */
+/* ------------------------------------------------------------------------ */
+
+// FNV-1a, as in FormRegistry
+unsigned long FormCodec::hashString(const char* str, size_t len)
+{
+	unsigned long hash = 2166136261UL;
+
+	for (size_t i = 0; i < len; i++)
+	{
+		hash ^= static_cast<unsigned char>(str[i]);
+		hash *= 16777619UL;
+	}
+	return hash;
+}
+
+size_t FormCodec::findSlot(const char* str, size_t len, unsigned long hash) const
+{
+	size_t i = hash & mask;
+
+	while (slots[i] != -1)
+	{
+		const std::string& s = strings[slots[i]];
+		if (hashes[slots[i]] == hash && s.size() == len
+			&& std::memcmp(s.data(), str, len) == 0)
+			break;
+		i = (i + 1) & mask;
+	}
+	return i;
+}
+
+void FormCodec::rehash(size_t capacity)
+{
+	slots.assign(capacity, -1);
+	mask = capacity - 1;
+	for (size_t n = 0; n < strings.size(); n++)
+	{
+		size_t i = hashes[n] & mask;
+		while (slots[i] != -1)
+			i = (i + 1) & mask;
+		slots[i] = static_cast<int>(n);
+	}
+}
+
+unsigned int FormCodec::intern(const std::string& str)
+{
+	unsigned long hash = hashString(str.data(), str.size());
+	size_t slot = findSlot(str.data(), str.size(), hash);
+
+	if (slots[slot] != -1)
+		return static_cast<unsigned int>(slots[slot]);
+	strings.push_back(str);
+	hashes.push_back(hash);
+	if (strings.size() * 2 > slots.size())
+		rehash(slots.size() * 2);
+	else
+		slots[slot] = static_cast<int>(strings.size() - 1);
+	return static_cast<unsigned int>(strings.size() - 1);
+}
+
+const std::string& FormCodec::stringAt(unsigned int index) const
+{
+	return strings[index];
+}
+
+size_t FormCodec::stringCount() const
+{
+	return strings.size();
+}
+
+void FormCodec::clear()
+{
+	strings.clear();
+	hashes.clear();
+	slots.assign(16, -1);
+	mask = 15;
+}
+
+static void putU32(unsigned char* out, unsigned int value)
+{
+	out[0] = static_cast<unsigned char>(value);
+	out[1] = static_cast<unsigned char>(value >> 8);
+	out[2] = static_cast<unsigned char>(value >> 16);
+	out[3] = static_cast<unsigned char>(value >> 24);
+}
+
+static unsigned int getU32(const unsigned char* in)
+{
+	return in[0] | (in[1] << 8) | (in[2] << 16) | (static_cast<unsigned int>(in[3]) << 24);
+}
+
+void FormCodec::saveStrings(std::vector<unsigned char>& out) const
+{
+	size_t size = 4;
+
+	for (size_t i = 0; i < strings.size(); i++)
+		size += 4 + strings[i].size();
+	size_t at = out.size();
+	out.resize(at + size);
+	putU32(&out[at], static_cast<unsigned int>(strings.size()));
+	at += 4;
+	for (size_t i = 0; i < strings.size(); i++)
+	{
+		putU32(&out[at], static_cast<unsigned int>(strings[i].size()));
+		if (!strings[i].empty())
+			std::memcpy(&out[at + 4], strings[i].data(), strings[i].size());
+		at += 4 + strings[i].size();
+	}
+}
+
+bool FormCodec::loadStrings(const unsigned char* data, size_t size)
+{
+	clear();
+	if (size < 4)
+		return false;
+	unsigned int count = getU32(data);
+	size_t at = 4;
+	for (unsigned int i = 0; i < count; i++)
+	{
+		if (size - at < 4)
+			return false;
+		unsigned int length = getU32(data + at);
+		at += 4;
+		if (size - at < length)
+			return false;
+		std::string str(reinterpret_cast<const char*>(data + at), length);
+		at += length;
+		// Not intern(): a duplicate would shift every index after it
+		strings.push_back(str);
+		hashes.push_back(hashString(str.data(), str.size()));
+	}
+	size_t capacity = 16;
+	while (capacity < strings.size() * 2 + 1)
+		capacity *= 2;
+	rehash(capacity);
+	return at == size;
+}
+
+/* ------------------------------------------------------------------------ */
+/*  Records                                                                  */
+/* ------------------------------------------------------------------------ */
+
+int FormCodec::typeOf(const AForm& form)
+{
+	if (dynamic_cast<const ShrubberyCreationForm*>(&form) != NULL)
+		return TYPE_SHRUBBERY;
+	if (dynamic_cast<const RobotomyRequestForm*>(&form) != NULL)
+		return TYPE_ROBOTOMY;
+	if (dynamic_cast<const PresidentialPardonForm*>(&form) != NULL)
+		return TYPE_PARDON;
+	return 0;
+}
+
+bool FormCodec::encodeForms(const AForm* const* forms, size_t count,
+	std::vector<unsigned char>& out)
+{
+	size_t at = out.size();
+
+	out.resize(at + count * RECORD_SIZE);
+	for (size_t i = 0; i < count; i++, at += RECORD_SIZE)
+	{
+		int type = typeOf(*forms[i]);
+		if (type == 0)
+		{
+			out.resize(at);
+			return false;
+		}
+		unsigned char* record = &out[at];
+		record[0] = static_cast<unsigned char>(type | (forms[i]->isFormSigned() ? SIGNED_BIT : 0));
+		record[1] = static_cast<unsigned char>(forms[i]->getGradeTosign());
+		record[2] = static_cast<unsigned char>(forms[i]->getGradeToExecute());
+		record[3] = 0;
+		putU32(record + 4, intern(forms[i]->getTarget()));
+	}
+	return true;
+}
+
+void FormCodec::encodeBureaucrats(const Bureaucrat* const* bureaucrats, size_t count,
+	std::vector<unsigned char>& out)
+{
+	size_t at = out.size();
+
+	out.resize(at + count * RECORD_SIZE);
+	for (size_t i = 0; i < count; i++, at += RECORD_SIZE)
+	{
+		unsigned char* record = &out[at];
+		record[0] = TYPE_BUREAUCRAT;
+		record[1] = static_cast<unsigned char>(bureaucrats[i]->getGrade());
+		record[2] = 0;
+		record[3] = 0;
+		putU32(record + 4, intern(bureaucrats[i]->getName()));
+	}
+}
+
+bool FormCodec::decodeForms(const unsigned char* data, size_t count,
+	std::vector<AForm*>& out) const
+{
+	for (size_t i = 0; i < count; i++, data += RECORD_SIZE)
+	{
+		int type = data[0] & ~SIGNED_BIT;
+		unsigned int target = getU32(data + 4);
+		if (type < TYPE_SHRUBBERY || type > TYPE_PARDON || data[3] != 0
+			|| data[1] != g_kinds[type].gradeToSign || data[2] != g_kinds[type].gradeToExecute
+			|| target >= strings.size())
+			return false;
+
+		AForm* form;
+		if (type == TYPE_SHRUBBERY)
+			form = new ShrubberyCreationForm(strings[target]);
+		else if (type == TYPE_ROBOTOMY)
+			form = new RobotomyRequestForm(strings[target]);
+		else
+			form = new PresidentialPardonForm(strings[target]);
+		form->isSigned = (data[0] & SIGNED_BIT) != 0;	// not shared with anyone yet
+		out.push_back(form);
+	}
+	return true;
+}
+
+bool FormCodec::decodeBureaucrats(const unsigned char* data, size_t count,
+	std::vector<Bureaucrat*>& out) const
+{
+	for (size_t i = 0; i < count; i++, data += RECORD_SIZE)
+	{
+		unsigned int name = getU32(data + 4);
+		if (data[0] != TYPE_BUREAUCRAT || data[1] < 1 || data[1] > 150
+			|| data[2] != 0 || data[3] != 0 || name >= strings.size())
+			return false;
+		out.push_back(new Bureaucrat(strings[name], data[1]));
+	}
+	return true;
+}
@@ -0,0 +1,91 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FormCodec.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/12/02 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/12/02 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef FORMCODEC_HPP
+#define FORMCODEC_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "AForm.hpp"
+#include "Bureaucrat.hpp"
+
+// Fixed-size binary snapshots of forms and bureaucrats. Every record is
+// RECORD_SIZE bytes, little-endian whatever the host:
+//   byte 0     type id, | SIGNED_BIT for a signed form
+//   byte 1     grade to sign (form) or grade (bureaucrat)
+//   byte 2     grade to execute (form), 0 for a bureaucrat
+//   byte 3     0
+//   bytes 4-7  index of the target (form) or name (bureaucrat) in the
+//              codec's string table
+// Strings are interned, so a million forms with a thousand targets store
+// each target once. The table travels separately (saveStrings /
+// loadStrings): a snapshot is the table plus the records.
+class FormCodec
+{
+public:
+	enum TypeId
+	{
+		TYPE_SHRUBBERY = 1,
+		TYPE_ROBOTOMY = 2,
+		TYPE_PARDON = 3,
+		TYPE_BUREAUCRAT = 4
+	};
+
+	static const size_t			RECORD_SIZE = 8;
+	static const unsigned char	SIGNED_BIT = 0x80;
+
+private:
+	std::vector<std::string>	strings;
+	std::vector<unsigned long>	hashes;
+	std::vector<int>			slots;	// index into strings, -1 when empty
+	size_t						mask;
+
+	static unsigned long	hashString(const char* str, size_t len);
+	size_t					findSlot(const char* str, size_t len, unsigned long hash) const;
+	void					rehash(size_t capacity);
+
+public:
+	FormCodec();
+	FormCodec(const FormCodec& other);
+	FormCodec& operator=(const FormCodec& other);
+	~FormCodec();
+
+	unsigned int		intern(const std::string& str);
+	const std::string&	stringAt(unsigned int index) const;
+	size_t				stringCount() const;
+	void				clear();
+
+	// 0 for a form that is not one of the three standard ones
+	static int			typeOf(const AForm& form);
+
+	// Append count records to out. encodeForms stops at a form it cannot
+	// type and returns false; the records before it stay in out.
+	bool	encodeForms(const AForm* const* forms, size_t count,
+				std::vector<unsigned char>& out);
+	void	encodeBureaucrats(const Bureaucrat* const* bureaucrats, size_t count,
+				std::vector<unsigned char>& out);
+
+	// Append count new objects (the caller deletes them) to out. Stops
+	// with false at the first record that is not valid: unknown type,
+	// grades that do not belong to it, or a string index out of range.
+	bool	decodeForms(const unsigned char* data, size_t count,
+				std::vector<AForm*>& out) const;
+	bool	decodeBureaucrats(const unsigned char* data, size_t count,
+				std::vector<Bureaucrat*>& out) const;
+
+	// u32 count, then u32 length and bytes for each string
+	void	saveStrings(std::vector<unsigned char>& out) const;
+	bool	loadStrings(const unsigned char* data, size_t size);	// replaces the table
+};
+
+#endif
@@ -0,0 +1,176 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FormExecutor.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/17 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/17 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "FormExecutor.hpp"
+#include <time.h>
+
+FormExecutor::FormExecutor(int threads) : pending(0), stopping(false), busyNs(0)
+{
+	if (threads < 1)
+		threads = 1;
+	pthread_mutex_init(&lock, NULL);
+	pthread_cond_init(&workReady, NULL);
+	pthread_cond_init(&allDone, NULL);
+	// Only threads that really started are kept (and joined later)
+	for (int i = 0; i < threads; i++)
+	{
+		pthread_t worker;
+		if (pthread_create(&worker, NULL, &FormExecutor::workerMain, this) == 0)
+			workers.push_back(worker);
+	}
+}
+
+FormExecutor::FormExecutor(const FormExecutor& other) : pending(0), stopping(false), busyNs(0)
+{
+	(void)other;
+}
+
+FormExecutor& FormExecutor::operator=(const FormExecutor& other)
+{
+	(void)other;
+	return *this;
+}
+
+FormExecutor::~FormExecutor()
+{
+	wait();
+	pthread_mutex_lock(&lock);
+	stopping = true;
+	pthread_cond_broadcast(&workReady);
+	pthread_mutex_unlock(&lock);
+	for (size_t i = 0; i < workers.size(); i++)
+		pthread_join(workers[i], NULL);
+	pthread_cond_destroy(&allDone);
+	pthread_cond_destroy(&workReady);
+	pthread_mutex_destroy(&lock);
+}
+
+double FormExecutor::now()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Same checks and action as Bureaucrat::executeForm, without printing
+void FormExecutor::run(const AForm& form, const Bureaucrat& executor, Result& result)
+{
+	result.actionFailed = false;
+	try
+	{
+		result.status = form.tryExecute(executor);
+	}
+	catch (const std::exception& e)
+	{
+		result.status = FORM_OK;
+		result.actionFailed = true;
+		result.error = e.what();
+	}
+}
+
+void* FormExecutor::workerMain(void* self)
+{
+	FormExecutor* pool = static_cast<FormExecutor*>(self);
+
+	pthread_mutex_lock(&pool->lock);
+	for (;;)
+	{
+		while (pool->queue.empty() && !pool->stopping)
+			pthread_cond_wait(&pool->workReady, &pool->lock);
+		if (pool->queue.empty())
+			break;
+		Job job = pool->queue.front();
+		pool->queue.pop_front();
+		pthread_mutex_unlock(&pool->lock);
+
+		double start = now();
+		run(*job.form, *job.executor, *job.result);
+		double end = now();
+		job.result->latencyNs = end - job.submitted;
+
+		pthread_mutex_lock(&pool->lock);
+		pool->busyNs += end - start;
+		if (--pool->pending == 0)
+			pthread_cond_broadcast(&pool->allDone);
+	}
+	pthread_mutex_unlock(&pool->lock);
+	return NULL;
+}
+
+size_t FormExecutor::submit(const AForm& form, const Bureaucrat& executor)
+{
+	Job job;
+
+	pthread_mutex_lock(&lock);
+	size_t ticket = results.size();
+	results.push_back(Result());
+	if (workers.empty())
+	{
+		// No worker could be started: run the job here instead
+		Result& result = results.back();
+		pthread_mutex_unlock(&lock);
+		double start = now();
+		run(form, executor, result);
+		double end = now();
+		result.latencyNs = end - start;
+		pthread_mutex_lock(&lock);
+		busyNs += end - start;
+		pthread_mutex_unlock(&lock);
+		return ticket;
+	}
+	job.form = &form;
+	job.executor = &executor;
+	job.result = &results.back();
+	job.submitted = now();
+	queue.push_back(job);
+	pending++;
+	pthread_cond_signal(&workReady);
+	pthread_mutex_unlock(&lock);
+	return ticket;
+}
+
+void FormExecutor::wait()
+{
+	pthread_mutex_lock(&lock);
+	while (pending > 0)
+		pthread_cond_wait(&allDone, &lock);
+	pthread_mutex_unlock(&lock);
+}
+
+const FormExecutor::Result& FormExecutor::result(size_t ticket) const
+{
+	return results[ticket];
+}
+
+size_t FormExecutor::resultCount() const
+{
+	return results.size();
+}
+
+void FormExecutor::clearResults()
+{
+	pthread_mutex_lock(&lock);
+	if (pending == 0)
+		results.clear();
+	pthread_mutex_unlock(&lock);
+}
+
+double FormExecutor::getBusyTime() const
+{
+	return busyNs;
+}
+
+int FormExecutor::getThreadCount() const
+{
+	return static_cast<int>(workers.size());
+}
@@ -0,0 +1,80 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FormExecutor.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/17 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/17 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef FORMEXECUTOR_HPP
+#define FORMEXECUTOR_HPP
+
+#include <pthread.h>
+#include <deque>
+#include <string>
+#include <vector>
+#include "AForm.hpp"
+#include "Bureaucrat.hpp"
+
+// Runs AForm::tryExecute on a fixed pool of worker threads. Each submitted
+// (form, executor) pair gets a ticket; once wait() returns, result(ticket)
+// tells how that execution went. The form and the bureaucrat must stay
+// alive until then, and a form should not be submitted twice at once.
+// The pool keeps the threads that could be started; with none at all,
+// submit() runs each job on the caller's thread before returning.
+class FormExecutor
+{
+public:
+	struct Result
+	{
+		FormResult	status;
+		bool		actionFailed;	// executeAction threw, see error
+		std::string	error;
+		double		latencyNs;		// from submit() to the end of the run
+	};
+
+private:
+	struct Job
+	{
+		const AForm*		form;
+		const Bureaucrat*	executor;
+		Result*				result;
+		double				submitted;
+	};
+
+	std::vector<pthread_t>	workers;
+	std::deque<Job>			queue;
+	std::deque<Result>		results;	// indexed by ticket, never moves
+	size_t					pending;	// submitted but not finished
+	bool					stopping;
+	double					busyNs;		// summed over the workers
+	pthread_mutex_t			lock;
+	pthread_cond_t			workReady;
+	pthread_cond_t			allDone;
+
+	FormExecutor(const FormExecutor& other);
+	FormExecutor& operator=(const FormExecutor& other);
+
+	static void*	workerMain(void* self);
+
+public:
+	FormExecutor(int threads);
+	~FormExecutor();	// finishes the queued jobs, then joins the workers
+
+	size_t			submit(const AForm& form, const Bureaucrat& executor);
+	void			wait();
+	const Result&	result(size_t ticket) const;
+	size_t			resultCount() const;
+	void			clearResults();	// only while nothing is pending
+	int				getThreadCount() const;	// threads actually started
+	double			getBusyTime() const;	// ns spent running jobs; read after wait()
+
+	static void		run(const AForm& form, const Bureaucrat& executor, Result& result);
+	static double	now();	// monotonic clock in nanoseconds
+};
+
+#endif
@@ -0,0 +1,225 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FormIndex.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/22 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/22 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "FormIndex.hpp"
+
+FormIndex::FormIndex() : pendingSign(0), pendingExecute(0)
+{
+	for (int w = 0; w < WORDS; w++)
+	{
+		signUsed[w] = 0;
+		executeUsed[w] = 0;
+	}
+}
+
+FormIndex::FormIndex(const FormIndex& other)
+{
+	*this = other;
+}
+
+FormIndex& FormIndex::operator=(const FormIndex& other)
+{
+	if (this != &other)
+	{
+		entries = other.entries;
+		for (int b = 0; b < BUCKETS; b++)
+		{
+			signBuckets[b] = other.signBuckets[b];
+			executeBuckets[b] = other.executeBuckets[b];
+		}
+		for (int w = 0; w < WORDS; w++)
+		{
+			signUsed[w] = other.signUsed[w];
+			executeUsed[w] = other.executeUsed[w];
+		}
+		pendingSign = other.pendingSign;
+		pendingExecute = other.pendingExecute;
+	}
+	return *this;
+}
+
+FormIndex::~FormIndex()
+{
+}
+
+// Puts the entry in the bucket matching its state
+void FormIndex::link(size_t id)
+{
+	Entry& e = entries[id];
+	std::vector<size_t>* buckets;
+	unsigned long long* used;
+	int grade;
+
+	if (e.state == AWAITING_SIGNATURE)
+	{
+		buckets = signBuckets;
+		used = signUsed;
+		grade = e.form->getGradeTosign();
+		pendingSign++;
+	}
+	else if (e.state == AWAITING_EXECUTION)
+	{
+		buckets = executeBuckets;
+		used = executeUsed;
+		grade = e.form->getGradeToExecute();
+		pendingExecute++;
+	}
+	else
+		return;
+	e.position = buckets[grade].size();
+	buckets[grade].push_back(id);
+	used[grade / 64] |= 1ULL << (grade % 64);
+}
+
+// Swap-and-pop out of its bucket, O(1)
+void FormIndex::unlink(size_t id)
+{
+	Entry& e = entries[id];
+	std::vector<size_t>* buckets;
+	unsigned long long* used;
+	int grade;
+
+	if (e.state == AWAITING_SIGNATURE)
+	{
+		buckets = signBuckets;
+		used = signUsed;
+		grade = e.form->getGradeTosign();
+		pendingSign--;
+	}
+	else if (e.state == AWAITING_EXECUTION)
+	{
+		buckets = executeBuckets;
+		used = executeUsed;
+		grade = e.form->getGradeToExecute();
+		pendingExecute--;
+	}
+	else
+		return;
+	std::vector<size_t>& bucket = buckets[grade];
+	size_t last = bucket.back();
+	bucket[e.position] = last;
+	entries[last].position = e.position;
+	bucket.pop_back();
+	if (bucket.empty())
+		used[grade / 64] &= ~(1ULL << (grade % 64));
+}
+
+size_t FormIndex::add(AForm& form)
+{
+	Entry e;
+
+	e.form = &form;
+	e.state = form.isFormSigned() ? AWAITING_EXECUTION : AWAITING_SIGNATURE;
+	e.position = 0;
+	entries.push_back(e);
+	link(entries.size() - 1);
+	return entries.size() - 1;
+}
+
+void FormIndex::remove(size_t id)
+{
+	unlink(id);
+	entries[id].state = REMOVED;
+}
+
+void FormIndex::refresh(size_t id)
+{
+	Entry& e = entries[id];
+
+	if (e.state == REMOVED || e.state == EXECUTED)
+		return;
+	State now = e.form->isFormSigned() ? AWAITING_EXECUTION : AWAITING_SIGNATURE;
+	if (now != e.state)
+	{
+		unlink(id);
+		e.state = now;
+		link(id);
+	}
+}
+
+FormResult FormIndex::sign(size_t id, const Bureaucrat& bureaucrat)
+{
+	FormResult result = entries[id].form->trySign(bureaucrat);
+
+	if (result == FORM_OK)
+		refresh(id);
+	return result;
+}
+
+FormResult FormIndex::execute(size_t id, const Bureaucrat& bureaucrat)
+{
+	Entry& e = entries[id];
+	FormResult result = e.form->tryExecute(bureaucrat);
+
+	if (result == FORM_OK && e.state == AWAITING_EXECUTION)
+	{
+		unlink(id);
+		e.state = EXECUTED;
+	}
+	return result;
+}
+
+// Walks only the occupied buckets from grade up to 150
+void FormIndex::collect(const std::vector<size_t>* buckets, const unsigned long long* used,
+	int grade, std::vector<size_t>& out)
+{
+	out.clear();
+	if (grade < 1)
+		grade = 1;
+	for (int w = grade / 64; w < WORDS; w++)
+	{
+		unsigned long long bits = used[w];
+		if (w == grade / 64)
+			bits &= ~0ULL << (grade % 64);
+		while (bits)
+		{
+			int b = w * 64 + __builtin_ctzll(bits);
+			out.insert(out.end(), buckets[b].begin(), buckets[b].end());
+			bits &= bits - 1;
+		}
+	}
+}
+
+void FormIndex::signable(int grade, std::vector<size_t>& out) const
+{
+	collect(signBuckets, signUsed, grade, out);
+}
+
+void FormIndex::executable(int grade, std::vector<size_t>& out) const
+{
+	collect(executeBuckets, executeUsed, grade, out);
+}
+
+AForm& FormIndex::form(size_t id) const
+{
+	return *entries[id].form;
+}
+
+FormIndex::State FormIndex::state(size_t id) const
+{
+	return entries[id].state;
+}
+
+size_t FormIndex::size() const
+{
+	return entries.size();
+}
+
+size_t FormIndex::awaitingSignature() const
+{
+	return pendingSign;
+}
+
+size_t FormIndex::awaitingExecution() const
+{
+	return pendingExecute;
+}
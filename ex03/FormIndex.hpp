@@ -0,0 +1,89 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FormIndex.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/22 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/22 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef FORMINDEX_HPP
+#define FORMINDEX_HPP
+
+#include <cstddef>
+#include <vector>
+#include "AForm.hpp"
+#include "Bureaucrat.hpp"
+
+// Pending forms bucketed by required grade. Unsigned forms sit in the
+// bucket of their grade to sign, signed but not yet executed forms in the
+// bucket of their grade to execute. A bitmap of non-empty buckets lets a
+// query skip straight to the buckets that hold results, so "what can a
+// grade g bureaucrat act on" costs the size of the answer, not a scan.
+// Sign and execute through the index (or call refresh) to keep it in sync.
+class FormIndex
+{
+public:
+	enum State
+	{
+		AWAITING_SIGNATURE,
+		AWAITING_EXECUTION,
+		EXECUTED,
+		REMOVED
+	};
+
+private:
+	static const int	BUCKETS = 151;	// grades 1..150, index = grade
+	static const int	WORDS = 3;		// 151 bits of occupancy
+
+	struct Entry
+	{
+		AForm*	form;
+		State	state;
+		size_t	position;	// inside its bucket
+	};
+
+	std::vector<Entry>	entries;
+	std::vector<size_t>	signBuckets[BUCKETS];
+	std::vector<size_t>	executeBuckets[BUCKETS];
+	unsigned long long	signUsed[WORDS];
+	unsigned long long	executeUsed[WORDS];
+	size_t				pendingSign;
+	size_t				pendingExecute;
+
+	void	link(size_t id);
+	void	unlink(size_t id);
+	static void	collect(const std::vector<size_t>* buckets, const unsigned long long* used,
+					int grade, std::vector<size_t>& out);
+
+public:
+	FormIndex();
+	FormIndex(const FormIndex& other);
+	FormIndex& operator=(const FormIndex& other);
+	~FormIndex();
+
+	// The index does not own the form; keep it alive while indexed
+	size_t		add(AForm& form);
+	void		remove(size_t id);
+	void		refresh(size_t id);	// re-read the form after an outside change
+
+	// trySign / tryExecute on the form, moving it between buckets
+	FormResult	sign(size_t id, const Bureaucrat& bureaucrat);
+	FormResult	execute(size_t id, const Bureaucrat& bureaucrat);
+
+	// Ids of the unsigned forms with grade to sign >= grade, and of the
+	// signed, not yet executed forms with grade to execute >= grade
+	void		signable(int grade, std::vector<size_t>& out) const;
+	void		executable(int grade, std::vector<size_t>& out) const;
+
+	AForm&		form(size_t id) const;
+	State		state(size_t id) const;
+	size_t		size() const;
+	size_t		awaitingSignature() const;
+	size_t		awaitingExecution() const;
+};
+
+#endif
@@ -0,0 +1,273 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FormPipeline.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/24 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/24 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "FormPipeline.hpp"
+#include <sched.h>
+#include <unistd.h>
+
+// Spin politely first, then sleep, so idle stages do not eat a core
+static void backoff(unsigned int& spins)
+{
+	if (++spins < 64)
+		sched_yield();
+	else
+		usleep(50);
+}
+
+static void raiseTo(size_t* target, size_t value)
+{
+	size_t current = __atomic_load_n(target, __ATOMIC_RELAXED);
+
+	while (value > current && !__atomic_compare_exchange_n(target, &current, value, true,
+			__ATOMIC_RELAXED, __ATOMIC_RELAXED))
+		;
+}
+
+FormPipeline::FormPipeline(const Bureaucrat& signer, const Bureaucrat& executor,
+	int intakeThreads, int signThreads, int executeThreads, size_t queueCapacity)
+	: signer(signer), executor(executor), submitted(0), completed(0), stopping(false)
+{
+	threadCounts[INTAKE] = intakeThreads;
+	threadCounts[SIGN] = signThreads;
+	threadCounts[EXECUTE] = executeThreads;
+	for (int s = 0; s < STAGE_COUNT; s++)
+	{
+		if (threadCounts[s] < 1)
+			threadCounts[s] = 1;
+		queues[s] = new LockFreeQueue<Job*>(queueCapacity);
+		counters[s].processed = 0;
+		counters[s].failed = 0;
+		counters[s].busyNs = 0;
+		counters[s].stalls = 0;
+		counters[s].maxDepth = 0;
+		counters[s].depthSum = 0;
+		for (int t = 0; t < threadCounts[s]; t++)
+		{
+			Worker worker;
+			worker.pipeline = this;
+			worker.stage = static_cast<Stage>(s);
+			workers.push_back(worker);
+		}
+	}
+	// workers is complete before any thread gets a pointer into it. Only
+	// the threads that started are kept, and counted in their stage.
+	int running[STAGE_COUNT] = { 0, 0, 0 };
+	for (size_t i = 0; i < workers.size(); i++)
+	{
+		pthread_t thread;
+		if (pthread_create(&thread, NULL, &FormPipeline::workerMain, &workers[i]) != 0)
+			continue;
+		threads.push_back(thread);
+		running[workers[i].stage]++;
+	}
+	bool complete = true;
+	for (int s = 0; s < STAGE_COUNT; s++)
+	{
+		threadCounts[s] = running[s];
+		complete = complete && running[s] > 0;
+	}
+	if (complete)
+		return;
+
+	// Nothing was submitted yet, so the started workers only see stopping
+	__atomic_store_n(&stopping, true, __ATOMIC_RELEASE);
+	for (size_t i = 0; i < threads.size(); i++)
+		pthread_join(threads[i], NULL);
+	for (int s = 0; s < STAGE_COUNT; s++)
+		delete queues[s];
+	throw ThreadStartException();
+}
+
+const char* FormPipeline::ThreadStartException::what() const throw()
+{
+	return "Could not start a thread for every pipeline stage";
+}
+
+FormPipeline::FormPipeline(const FormPipeline& other)
+	: signer(other.signer), executor(other.executor), submitted(0), completed(0), stopping(true)
+{
+	for (int s = 0; s < STAGE_COUNT; s++)
+		queues[s] = NULL;
+}
+
+FormPipeline& FormPipeline::operator=(const FormPipeline& other)
+{
+	(void)other;
+	return *this;
+}
+
+FormPipeline::~FormPipeline()
+{
+	finish();
+	__atomic_store_n(&stopping, true, __ATOMIC_RELEASE);
+	for (size_t i = 0; i < threads.size(); i++)
+		pthread_join(threads[i], NULL);
+	for (size_t i = 0; i < jobs.size(); i++)
+		delete jobs[i].form;
+	for (int s = 0; s < STAGE_COUNT; s++)
+		delete queues[s];
+}
+
+void* FormPipeline::workerMain(void* arg)
+{
+	Worker* worker = static_cast<Worker*>(arg);
+
+	worker->pipeline->runStage(worker->stage);
+	return NULL;
+}
+
+void FormPipeline::runStage(Stage stage)
+{
+	LockFreeQueue<Job*>& input = *queues[stage];
+	Counters& counter = counters[stage];
+	unsigned int spins = 0;
+	Job* job;
+
+	for (;;)
+	{
+		if (!input.tryPop(job))
+		{
+			if (__atomic_load_n(&stopping, __ATOMIC_ACQUIRE))
+				break;
+			backoff(spins);
+			continue;
+		}
+		spins = 0;
+		size_t depth = input.size();
+		__atomic_fetch_add(&counter.depthSum, depth, __ATOMIC_RELAXED);
+		raiseTo(&counter.maxDepth, depth);
+
+		double start = FormExecutor::now();
+		bool passed = process(stage, *job);
+		double end = FormExecutor::now();
+
+		__atomic_fetch_add(&counter.busyNs, static_cast<unsigned long long>(end - start),
+			__ATOMIC_RELAXED);
+		__atomic_fetch_add(&counter.processed, 1, __ATOMIC_RELAXED);
+		if (!passed)
+			__atomic_fetch_add(&counter.failed, 1, __ATOMIC_RELAXED);
+		if (passed && stage != EXECUTE)
+			push(static_cast<Stage>(stage + 1), job);
+		else
+			complete(*job);
+	}
+}
+
+// Runs one stage on the job; false if it should leave the pipeline
+bool FormPipeline::process(Stage stage, Job& job)
+{
+	if (stage == INTAKE)
+	{
+		try
+		{
+			job.form = intern.createForm(job.request.formName, job.request.target);
+		}
+		catch (const std::exception&)
+		{
+			job.form = NULL;
+		}
+		return job.form != NULL;
+	}
+	if (stage == SIGN)
+	{
+		job.signStatus = job.form->trySign(signer);
+		return job.signStatus == FORM_OK;
+	}
+	FormExecutor::run(*job.form, executor, job.execution);
+	return job.execution.status == FORM_OK && !job.execution.actionFailed;
+}
+
+// Backpressure: wait for room in the next stage's queue
+void FormPipeline::push(Stage stage, Job* job)
+{
+	unsigned int spins = 0;
+
+	while (!queues[stage]->tryPush(job))
+	{
+		__atomic_fetch_add(&counters[stage - 1].stalls, 1, __ATOMIC_RELAXED);
+		backoff(spins);
+	}
+}
+
+void FormPipeline::complete(Job& job)
+{
+	job.latencyNs = FormExecutor::now() - job.submitted;
+	__atomic_fetch_add(&completed, 1, __ATOMIC_RELEASE);
+}
+
+size_t FormPipeline::submit(const FormRequest& request)
+{
+	Job job;
+	unsigned int spins = 0;
+
+	job.request = request;
+	job.form = NULL;
+	job.signStatus = FORM_NOT_SIGNED;
+	job.execution.status = FORM_NOT_SIGNED;
+	job.execution.actionFailed = false;
+	job.execution.latencyNs = 0;
+	job.latencyNs = 0;
+	jobs.push_back(job);
+	Job* queued = &jobs.back();
+	queued->submitted = FormExecutor::now();
+	submitted++;
+	while (!queues[INTAKE]->tryPush(queued))
+		backoff(spins);
+	return jobs.size() - 1;
+}
+
+void FormPipeline::finish()
+{
+	unsigned int spins = 0;
+
+	while (__atomic_load_n(&completed, __ATOMIC_ACQUIRE) < submitted)
+		backoff(spins);
+}
+
+const FormPipeline::Job& FormPipeline::result(size_t ticket) const
+{
+	return jobs[ticket];
+}
+
+size_t FormPipeline::jobCount() const
+{
+	return jobs.size();
+}
+
+size_t FormPipeline::queueDepth(Stage stage) const
+{
+	return queues[stage]->size();
+}
+
+FormPipeline::StageStats FormPipeline::stats(Stage stage) const
+{
+	const Counters& counter = counters[stage];
+	StageStats stats;
+
+	stats.threads = threadCounts[stage];
+	stats.processed = __atomic_load_n(&counter.processed, __ATOMIC_RELAXED);
+	stats.failed = __atomic_load_n(&counter.failed, __ATOMIC_RELAXED);
+	stats.busyNs = static_cast<double>(__atomic_load_n(&counter.busyNs, __ATOMIC_RELAXED));
+	stats.stalls = __atomic_load_n(&counter.stalls, __ATOMIC_RELAXED);
+	stats.maxDepth = __atomic_load_n(&counter.maxDepth, __ATOMIC_RELAXED);
+	stats.meanDepth = stats.processed
+		? static_cast<double>(__atomic_load_n(&counter.depthSum, __ATOMIC_RELAXED)) / stats.processed
+		: 0;
+	return stats;
+}
+
+const char* FormPipeline::stageName(Stage stage)
+{
+	static const char* names[STAGE_COUNT] = { "intake", "sign", "execute" };
+
+	return names[stage];
+}
@@ -0,0 +1,134 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FormPipeline.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/24 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/24 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef FORMPIPELINE_HPP
+#define FORMPIPELINE_HPP
+
+#include <pthread.h>
+#include <deque>
+#include <vector>
+#include "AForm.hpp"
+#include "Bureaucrat.hpp"
+#include "Intern.hpp"
+#include "FormBatch.hpp"
+#include "FormExecutor.hpp"
+#include "LockFreeQueue.hpp"
+
+// The intern -> signForm -> executeForm sequence as three stages, each on
+// its own threads, joined by bounded LockFreeQueues. A stage that finds
+// the next queue full waits for room, so a slow stage holds back the ones
+// before it (and submit() itself) instead of letting the queues grow.
+// Per-stage counters show which stage limits the whole line.
+// Forms are created through the Intern registry; do not register new
+// forms while a pipeline is running.
+class FormPipeline
+{
+public:
+	enum Stage
+	{
+		INTAKE,
+		SIGN,
+		EXECUTE,
+		STAGE_COUNT
+	};
+
+	// Outcome of one submitted request
+	struct Job
+	{
+		FormRequest				request;
+		AForm*					form;		// NULL if the intern did not know the name
+		FormResult				signStatus;
+		FormExecutor::Result	execution;	// meaningful once signStatus is FORM_OK
+		double					submitted;
+		double					latencyNs;	// from submit() to leaving the pipeline
+	};
+
+	struct StageStats
+	{
+		int		threads;
+		size_t	processed;
+		size_t	failed;		// unknown form, refused signature, failed execution
+		double	busyNs;		// summed over the stage's threads
+		size_t	stalls;		// waits for room in the next queue
+		size_t	maxDepth;	// deepest the input queue was seen
+		double	meanDepth;	// input queue depth, averaged over pops
+	};
+
+private:
+	struct Counters
+	{
+		size_t				processed;
+		size_t				failed;
+		unsigned long long	busyNs;
+		size_t				stalls;
+		size_t				maxDepth;
+		size_t				depthSum;
+		char				pad[16];	// one cache line per stage
+	};
+
+	struct Worker
+	{
+		FormPipeline*	pipeline;
+		Stage			stage;
+	};
+
+	const Bureaucrat&		signer;
+	const Bureaucrat&		executor;
+	Intern					intern;
+	LockFreeQueue<Job*>*	queues[STAGE_COUNT];	// input of each stage
+	int						threadCounts[STAGE_COUNT];
+	Counters				counters[STAGE_COUNT];
+	std::vector<pthread_t>	threads;
+	std::vector<Worker>		workers;
+	std::deque<Job>			jobs;		// indexed by ticket, never moves
+	size_t					submitted;
+	size_t					completed;
+	bool					stopping;
+
+	FormPipeline(const FormPipeline& other);
+	FormPipeline& operator=(const FormPipeline& other);
+
+	static void*	workerMain(void* arg);
+	void			runStage(Stage stage);
+	bool			process(Stage stage, Job& job);
+	void			push(Stage stage, Job* job);
+	void			complete(Job& job);
+
+public:
+	// A stage kept none of its threads (pthread_create failed for all)
+	class ThreadStartException : public std::exception
+	{
+		public:
+			const char* what() const throw();
+	};
+
+	// signer signs every form, executor executes them. Both must outlive
+	// the pipeline. Queue capacity is rounded up to a power of two. A
+	// stage runs on the threads that could be started; if a stage got
+	// none, the others are stopped and ThreadStartException is thrown.
+	FormPipeline(const Bureaucrat& signer, const Bureaucrat& executor,
+		int intakeThreads = 1, int signThreads = 1, int executeThreads = 1,
+		size_t queueCapacity = 1024);
+	~FormPipeline();	// drains every submitted job, then joins and deletes the forms
+
+	// Call from one thread only. Waits while the intake queue is full.
+	size_t			submit(const FormRequest& request);
+	void			finish();	// returns once every submitted job is done
+	const Job&		result(size_t ticket) const;	// complete after finish()
+	size_t			jobCount() const;
+	size_t			queueDepth(Stage stage) const;
+	StageStats		stats(Stage stage) const;
+
+	static const char*	stageName(Stage stage);
+};
+
+#endif
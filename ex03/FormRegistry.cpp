@@ -0,0 +1,167 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FormRegistry.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/10 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/10 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "FormRegistry.hpp"
+#include <cstring>
+
+FormRegistry::FormRegistry() : slots(8, -1), mask(7)
+{
+}
+
+FormRegistry::FormRegistry(const FormRegistry& other)
+	: entries(other.entries), slots(other.slots), mask(other.mask)
+{
+}
+
+FormRegistry& FormRegistry::operator=(const FormRegistry& other)
+{
+	if (this != &other)
+	{
+		entries = other.entries;
+		slots = other.slots;
+		mask = other.mask;
+	}
+	return *this;
+}
+
+FormRegistry::~FormRegistry()
+{
+}
+
+// FNV-1a, good enough for short form names
+unsigned long FormRegistry::hashName(const char* str, size_t len)
+{
+	unsigned long hash = 2166136261UL;
+
+	for (size_t i = 0; i < len; i++)
+	{
+		hash ^= static_cast<unsigned char>(str[i]);
+		hash *= 16777619UL;
+	}
+	return hash;
+}
+
+// Returns the slot holding the name, or the empty slot where it would go
+int FormRegistry::findSlot(const char* str, size_t len, unsigned long hash) const
+{
+	size_t i = hash & mask;
+
+	while (slots[i] != -1)
+	{
+		const Entry& e = entries[slots[i]];
+		if (e.hash == hash && e.name.size() == len
+			&& std::memcmp(e.name.data(), str, len) == 0)
+			break;
+		i = (i + 1) & mask;
+	}
+	return static_cast<int>(i);
+}
+
+void FormRegistry::rehash(size_t capacity)
+{
+	slots.assign(capacity, -1);
+	mask = capacity - 1;
+	for (size_t n = 0; n < entries.size(); n++)
+	{
+		size_t i = entries[n].hash & mask;
+		while (slots[i] != -1)
+			i = (i + 1) & mask;
+		slots[i] = static_cast<int>(n);
+	}
+}
+
+bool FormRegistry::add(const std::string& name, FormCreator creator)
+{
+	FormType type;
+
+	type.create = creator;
+	type.place = NULL;
+	type.size = 0;
+	return add(name, type);
+}
+
+bool FormRegistry::add(const std::string& name, const FormType& type)
+{
+	if (type.create == NULL)
+		return false;
+
+	unsigned long hash = hashName(name.data(), name.size());
+	int slot = findSlot(name.data(), name.size(), hash);
+	if (slots[slot] != -1)
+		return false;
+
+	Entry e;
+	e.name = name;
+	e.hash = hash;
+	e.type = type;
+	entries.push_back(e);
+
+	// Keep the load factor under 1/2 so probe chains stay short
+	if (entries.size() * 2 > slots.size())
+		rehash(slots.size() * 2);
+	else
+		slots[slot] = static_cast<int>(entries.size() - 1);
+	return true;
+}
+
+FormCreator FormRegistry::find(const std::string& name) const
+{
+	const FormType* type = lookup(name);
+
+	if (type == NULL)
+		return NULL;
+	return type->create;
+}
+
+const FormType* FormRegistry::lookup(const std::string& name) const
+{
+	int index = indexOf(name);
+
+	if (index == -1)
+		return NULL;
+	return &entries[index].type;
+}
+
+int FormRegistry::indexOf(const std::string& name) const
+{
+	unsigned long hash = hashName(name.data(), name.size());
+
+	return slots[findSlot(name.data(), name.size(), hash)];
+}
+
+const FormType& FormRegistry::typeAt(size_t index) const
+{
+	return entries[index].type;
+}
+
+const std::string& FormRegistry::nameAt(size_t index) const
+{
+	return entries[index].name;
+}
+
+size_t FormRegistry::size() const
+{
+	return entries.size();
+}
+
+std::string FormRegistry::listNames() const
+{
+	std::string list;
+
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		if (i)
+			list += ", ";
+		list += entries[i].name;
+	}
+	return list;
+}
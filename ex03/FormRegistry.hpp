@@ -0,0 +1,74 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FormRegistry.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/10 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/10 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef FORMREGISTRY_HPP
+#define FORMREGISTRY_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "AForm.hpp"
+
+// Function that builds a form for a given target
+typedef AForm* (*FormCreator)(const std::string& target);
+
+// Same, but constructs the form in caller-provided memory
+typedef AForm* (*FormPlacer)(void* where, const std::string& target);
+
+// Everything the registry knows about one kind of form
+struct FormType
+{
+	FormCreator	create;
+	FormPlacer	place;	// NULL if the form cannot live in an arena
+	size_t		size;	// sizeof the concrete form, needed by place
+};
+
+// Maps form names to creators through an open-addressing hash index.
+// The index is built on registration, so a lookup only hashes the name
+// and probes a slot or two, without allocating anything.
+class FormRegistry
+{
+private:
+	struct Entry
+	{
+		std::string		name;
+		unsigned long	hash;
+		FormType		type;
+	};
+
+	std::vector<Entry>	entries;	// registration order (used for listings)
+	std::vector<int>	slots;		// index into entries, -1 when empty
+	size_t				mask;
+
+	static unsigned long	hashName(const char* str, size_t len);
+	int						findSlot(const char* str, size_t len, unsigned long hash) const;
+	void					rehash(size_t capacity);
+
+public:
+	FormRegistry();
+	FormRegistry(const FormRegistry& other);
+	FormRegistry& operator=(const FormRegistry& other);
+	~FormRegistry();
+
+	// Returns false if the name is already taken or the creator is NULL
+	bool			add(const std::string& name, FormCreator creator);
+	bool			add(const std::string& name, const FormType& type);
+	FormCreator		find(const std::string& name) const;
+	const FormType*	lookup(const std::string& name) const;	// valid until the next add
+	int				indexOf(const std::string& name) const;	// -1 if unknown
+	const FormType&	typeAt(size_t index) const;
+	const std::string&	nameAt(size_t index) const;
+	size_t			size() const;
+	std::string		listNames() const;
+};
+
+#endif
@@ -0,0 +1,204 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FormTable.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/21 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/21 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "FormTable.hpp"
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+
+FormTable::FormTable() : count(0)
+{
+}
+
+FormTable::FormTable(const FormTable& other)
+	: signGrades(other.signGrades), executeGrades(other.executeGrades),
+	  signedFlags(other.signedFlags), typeIds(other.typeIds),
+	  typeNames(other.typeNames), typeIndex(other.typeIndex), count(other.count)
+{
+}
+
+FormTable& FormTable::operator=(const FormTable& other)
+{
+	if (this != &other)
+	{
+		signGrades = other.signGrades;
+		executeGrades = other.executeGrades;
+		signedFlags = other.signedFlags;
+		typeIds = other.typeIds;
+		typeNames = other.typeNames;
+		typeIndex = other.typeIndex;
+		count = other.count;
+	}
+	return *this;
+}
+
+FormTable::~FormTable()
+{
+}
+
+size_t FormTable::add(const AForm& form)
+{
+	const std::string& name = form.getName();
+	std::map<std::string, unsigned char>::const_iterator found = typeIndex.find(name);
+	unsigned char type;
+
+	if (found != typeIndex.end())
+		type = found->second;
+	else
+	{
+		if (typeNames.size() == MAX_TYPES)
+			throw TooManyTypesException();
+		type = static_cast<unsigned char>(typeNames.size());
+		typeNames.push_back(name);
+		typeIndex[name] = type;
+	}
+	return add(form.getGradeTosign(), form.getGradeToExecute(), form.isFormSigned(), type);
+}
+
+size_t FormTable::add(int gradeToSign, int gradeToExecute, bool isSigned, unsigned char typeId)
+{
+	if (count % 16 == 0)
+	{
+		// Grade 0 is below every bureaucrat, so padding never matches
+		signGrades.resize(count + 16, 0);
+		executeGrades.resize(count + 16, 0);
+		signedFlags.resize(count + 16, 0);
+		typeIds.resize(count + 16, 0);
+	}
+	signGrades[count] = static_cast<unsigned char>(gradeToSign);
+	executeGrades[count] = static_cast<unsigned char>(gradeToExecute);
+	signedFlags[count] = isSigned ? 0xFF : 0;
+	typeIds[count] = typeId;
+	return count++;
+}
+
+void FormTable::setSigned(size_t row, bool isSigned)
+{
+	signedFlags[row] = isSigned ? 0xFF : 0;
+}
+
+void FormTable::clear()
+{
+	signGrades.clear();
+	executeGrades.clear();
+	signedFlags.clear();
+	typeIds.clear();
+	count = 0;
+}
+
+const char* FormTable::TooManyTypesException::what() const throw()
+{
+	return "Too many form types for a FormTable";
+}
+
+size_t FormTable::size() const
+{
+	return count;
+}
+
+int FormTable::getGradeToSign(size_t row) const
+{
+	return signGrades[row];
+}
+
+int FormTable::getGradeToExecute(size_t row) const
+{
+	return executeGrades[row];
+}
+
+bool FormTable::isSigned(size_t row) const
+{
+	return signedFlags[row] != 0;
+}
+
+unsigned char FormTable::getTypeId(size_t row) const
+{
+	return typeIds[row];
+}
+
+const std::string& FormTable::getTypeName(unsigned char typeId) const
+{
+	return typeNames[typeId];
+}
+
+// Bit i is set when grades[i] >= grade (and form i is signed, if asked)
+void FormTable::compare(const std::vector<unsigned char>& grades, bool needSigned,
+	int grade, Mask& mask) const
+{
+	mask.assign((count + 63) / 64, 0);
+	if (grade < 1 || grade > 255)
+		return;
+#ifdef __SSE2__
+	const __m128i wanted = _mm_set1_epi8(static_cast<char>(grade));
+	const unsigned char* column = grades.empty() ? NULL : &grades[0];
+	const unsigned char* flags = signedFlags.empty() ? NULL : &signedFlags[0];
+
+	for (size_t row = 0; row < count; row += 16)
+	{
+		__m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(column + row));
+		// Unsigned a >= b  <=>  max(a, b) == a
+		__m128i ok = _mm_cmpeq_epi8(_mm_max_epu8(values, wanted), values);
+		if (needSigned)
+			ok = _mm_and_si128(ok, _mm_loadu_si128(reinterpret_cast<const __m128i*>(flags + row)));
+		unsigned long long bits = static_cast<unsigned int>(_mm_movemask_epi8(ok));
+		mask[row / 64] |= bits << (row % 64);
+	}
+	// Padding rows have grade 0 and never match, but keep the tail clean
+	if (count % 64)
+		mask.back() &= (1ULL << (count % 64)) - 1;
+#else
+	for (size_t row = 0; row < count; row++)
+		if (grades[row] >= grade && (!needSigned || signedFlags[row]))
+			mask[row / 64] |= 1ULL << (row % 64);
+#endif
+}
+
+void FormTable::signableMask(int grade, Mask& mask) const
+{
+	compare(signGrades, false, grade, mask);
+}
+
+void FormTable::executableMask(int grade, Mask& mask) const
+{
+	compare(executeGrades, true, grade, mask);
+}
+
+// Mirrors AForm::trySign: only the grade matters, re-signing is allowed
+void FormTable::signableMaskScalar(int grade, Mask& mask) const
+{
+	mask.assign((count + 63) / 64, 0);
+	if (grade < 1 || grade > 255)
+		return;
+	for (size_t row = 0; row < count; row++)
+		if (!(grade > signGrades[row]))
+			mask[row / 64] |= 1ULL << (row % 64);
+}
+
+// Mirrors AForm::tryExecute: signed first, then the grade
+void FormTable::executableMaskScalar(int grade, Mask& mask) const
+{
+	mask.assign((count + 63) / 64, 0);
+	if (grade < 1 || grade > 255)
+		return;
+	for (size_t row = 0; row < count; row++)
+		if (signedFlags[row] && !(grade > executeGrades[row]))
+			mask[row / 64] |= 1ULL << (row % 64);
+}
+
+size_t FormTable::countBits(const Mask& mask)
+{
+	size_t total = 0;
+
+	for (size_t i = 0; i < mask.size(); i++)
+		total += __builtin_popcountll(mask[i]);
+	return total;
+}
@@ -0,0 +1,85 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FormTable.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/21 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/21 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef FORMTABLE_HPP
+#define FORMTABLE_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include "AForm.hpp"
+
+// Column snapshot of many forms: grade to sign, grade to execute, signed
+// flag and type id each live in their own packed byte array (grades are
+// 1..150, so a byte is enough). Eligibility for a bureaucrat grade is then
+// a linear scan comparing 16 forms per SSE2 instruction instead of two
+// virtual-free but cache-missing calls per AForm.
+class FormTable
+{
+public:
+	typedef std::vector<unsigned long long>	Mask;	// bit i = form i
+
+	// Type ids are one byte, like the grades
+	static const size_t	MAX_TYPES = 256;
+
+private:
+	// Padded to a multiple of 16 with entries that never match
+	std::vector<unsigned char>	signGrades;
+	std::vector<unsigned char>	executeGrades;
+	std::vector<unsigned char>	signedFlags;
+	std::vector<unsigned char>	typeIds;
+	std::vector<std::string>	typeNames;	// by type id
+	std::map<std::string, unsigned char>	typeIndex;	// form name -> type id
+	size_t						count;
+
+	void	compare(const std::vector<unsigned char>& grades, bool needSigned,
+				int grade, Mask& mask) const;
+
+public:
+	FormTable();
+	FormTable(const FormTable& other);
+	FormTable& operator=(const FormTable& other);
+	~FormTable();
+
+	// Returns the row of the new entry. Each distinct form name gets the
+	// next type id; the 257th throws TooManyTypesException.
+	size_t	add(const AForm& form);
+	size_t	add(int gradeToSign, int gradeToExecute, bool isSigned, unsigned char typeId);
+	void	setSigned(size_t row, bool isSigned);
+	void	clear();	// drops the rows; type ids and names stay valid
+
+	size_t				size() const;
+	int					getGradeToSign(size_t row) const;
+	int					getGradeToExecute(size_t row) const;
+	bool				isSigned(size_t row) const;
+	unsigned char		getTypeId(size_t row) const;
+	const std::string&	getTypeName(unsigned char typeId) const;
+
+	// Rows where beSigned / execute by a bureaucrat of this grade would
+	// pass their checks: SIMD when SSE2 is available, else the scalar code
+	void	signableMask(int grade, Mask& mask) const;
+	void	executableMask(int grade, Mask& mask) const;
+
+	// One row at a time, same rules; kept as the reference implementation
+	void	signableMaskScalar(int grade, Mask& mask) const;
+	void	executableMaskScalar(int grade, Mask& mask) const;
+
+	static size_t	countBits(const Mask& mask);
+
+	class TooManyTypesException : public std::exception
+	{
+		public:
+			const char* what() const throw();
+	};
+};
+
+#endif
@@ -12,6 +12,7 @@
 
 #include "Intern.hpp"
 #include <iostream>
+#include <new>
 
 Intern::Intern()
 {
@@ -33,49 +34,175 @@ Intern::~Intern()
 }
 
 // Helper functions to create forms
-AForm* Intern::createShrubberyForm(const std::string& target) const
+AForm* Intern::createShrubberyForm(const std::string& target)
 {
 	return new ShrubberyCreationForm(target);
 }
 
-AForm* Intern::createRobotomyForm(const std::string& target) const
+AForm* Intern::createRobotomyForm(const std::string& target)
 {
 	return new RobotomyRequestForm(target);
 }
 
-AForm* Intern::createPresidentialForm(const std::string& target) const
+AForm* Intern::createPresidentialForm(const std::string& target)
 {
 	return new PresidentialPardonForm(target);
 }
 
+AForm* Intern::placeShrubberyForm(void* where, const std::string& target)
+{
+	return new (where) ShrubberyCreationForm(target);
+}
+
+AForm* Intern::placeRobotomyForm(void* where, const std::string& target)
+{
+	return new (where) RobotomyRequestForm(target);
+}
+
+AForm* Intern::placePresidentialForm(void* where, const std::string& target)
+{
+	return new (where) PresidentialPardonForm(target);
+}
+
+// The three standard forms, filled in before anyone can see the registry
+FormRegistry Intern::defaultRegistry()
+{
+	FormRegistry forms;
+	FormType shrubbery = { &Intern::createShrubberyForm, &Intern::placeShrubberyForm,
+						   sizeof(ShrubberyCreationForm) };
+	FormType robotomy = { &Intern::createRobotomyForm, &Intern::placeRobotomyForm,
+						  sizeof(RobotomyRequestForm) };
+	FormType presidential = { &Intern::createPresidentialForm, &Intern::placePresidentialForm,
+							  sizeof(PresidentialPardonForm) };
+
+	forms.add("shrubbery creation", shrubbery);
+	forms.add("robotomy request", robotomy);
+	forms.add("presidential pardon", presidential);
+	return forms;
+}
+
+// The static is initialized once, under the compiler's guard, so threads
+// that reach it together (FormPipeline's intake workers) all see the
+// filled registry. Only registerForm writes to it afterwards.
+FormRegistry& Intern::registry()
+{
+	static FormRegistry forms = defaultRegistry();
+
+	return forms;
+}
+
+bool Intern::registerForm(const std::string& formName, FormCreator creator)
+{
+	return registry().add(formName, creator);
+}
+
+bool Intern::registerForm(const std::string& formName, const FormType& type)
+{
+	return registry().add(formName, type);
+}
+
 AForm* Intern::makeForm(const std::string& formName, const std::string& target) const
 {
-	// Array of form names
-	const std::string formNames[3] = {
-		"shrubbery creation",
-		"robotomy request",
-		"presidential pardon"
-	};
-	
-	// Array of function pointers (member function pointers)
-	AForm* (Intern::*formCreators[3])(const std::string&) const = {
-		&Intern::createShrubberyForm,
-		&Intern::createRobotomyForm,
-		&Intern::createPresidentialForm
-	};
-	
-	// Find and create the appropriate form
-	for (int i = 0; i < 3; i++)
+	FormCreator creator = registry().find(formName);
+
+	if (creator != NULL)
 	{
-		if (formName == formNames[i])
-		{
-			std::cout << "Intern creates " << formName << std::endl;
-			return (this->*formCreators[i])(target);
-		}
+		std::cout << "Intern creates " << formName << std::endl;
+		return creator(target);
 	}
-	
+
 	// Form name not found
 	std::cerr << "Error: Form name \"" << formName << "\" does not exist." << std::endl;
-	std::cerr << "Available forms: shrubbery creation, robotomy request, presidential pardon" << std::endl;
+	std::cerr << "Available forms: " << registry().listNames() << std::endl;
 	return NULL;
 }
+
+AForm* Intern::createForm(const std::string& formName, const std::string& target) const
+{
+	FormCreator creator = registry().find(formName);
+
+	if (creator == NULL)
+		return NULL;
+	return creator(target);
+}
+
+AForm* Intern::makeForm(const std::string& formName, const std::string& target, FormArena& arena) const
+{
+	const FormType* type = registry().lookup(formName);
+
+	if (type == NULL)
+	{
+		std::cerr << "Error: Form name \"" << formName << "\" does not exist." << std::endl;
+		std::cerr << "Available forms: " << registry().listNames() << std::endl;
+		return NULL;
+	}
+
+	AForm* form = arena.create(*type, target);
+	if (form == NULL)
+	{
+		std::cerr << "Error: No arena slot for \"" << formName << "\"." << std::endl;
+		return NULL;
+	}
+	std::cout << "Intern creates " << formName << std::endl;
+	return form;
+}
+
+size_t Intern::makeForms(const std::vector<FormRequest>& requests, FormBatch& batch) const
+{
+	const FormRegistry& forms = registry();
+	const size_t n = requests.size();
+	std::vector<int> types(n);
+	std::vector<size_t> start(forms.size() + 1, 0);
+
+	batch.clear();
+	batch.statuses.assign(n, FormBatch::CREATED);
+	batch.positions.assign(n, 0);
+
+	// Resolve every name once and count the forms of each type
+	for (size_t i = 0; i < n; i++)
+	{
+		types[i] = forms.indexOf(requests[i].formName);
+		if (types[i] == -1)
+			batch.statuses[i] = FormBatch::UNKNOWN_FORM;
+		else if (forms.typeAt(types[i]).place == NULL
+				|| forms.typeAt(types[i]).size > FormArena::SLOT_SIZE)
+			batch.statuses[i] = FormBatch::NOT_PLACEABLE;
+		else
+			start[types[i] + 1]++;
+	}
+
+	// Counting sort: requests ordered by type, stable within a type
+	for (size_t t = 0; t < forms.size(); t++)
+		start[t + 1] += start[t];
+	std::vector<size_t> order(start[forms.size()]);
+	for (size_t i = 0; i < n; i++)
+		if (batch.statuses[i] == FormBatch::CREATED)
+			order[start[types[i]]++] = i;
+
+	batch.arena.reset(order.size());
+	for (size_t k = 0; k < order.size(); k++)
+	{
+		size_t i = order[k];
+		const FormType& type = forms.typeAt(types[i]);
+
+		if (k == 0 || types[i] != types[order[k - 1]])
+		{
+			FormBatch::Group group;
+			group.formName = forms.nameAt(types[i]);
+			group.begin = batch.arena.size();
+			group.end = group.begin;
+			batch.groups.push_back(group);
+		}
+		try
+		{
+			batch.arena.create(type, requests[i].target);
+			batch.positions[i] = batch.arena.size() - 1;
+			batch.groups.back().end = batch.arena.size();
+		}
+		catch (const std::exception&)
+		{
+			batch.statuses[i] = FormBatch::FAILED;
+		}
+	}
+	return batch.arena.size();
+}
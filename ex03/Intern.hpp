@@ -18,14 +18,26 @@
 #include "ShrubberyCreationForm.hpp"
 #include "RobotomyRequestForm.hpp"
 #include "PresidentialPardonForm.hpp"
+#include "FormRegistry.hpp"
+#include "FormArena.hpp"
+#include "FormBatch.hpp"
 
 class Intern
 {
 private:
 	// Helper functions to create each type of form
-	AForm* createShrubberyForm(const std::string& target) const;
-	AForm* createRobotomyForm(const std::string& target) const;
-	AForm* createPresidentialForm(const std::string& target) const;
+	static AForm* createShrubberyForm(const std::string& target);
+	static AForm* createRobotomyForm(const std::string& target);
+	static AForm* createPresidentialForm(const std::string& target);
+
+	// Same, constructed in place (used by the arena overload of makeForm)
+	static AForm* placeShrubberyForm(void* where, const std::string& target);
+	static AForm* placeRobotomyForm(void* where, const std::string& target);
+	static AForm* placePresidentialForm(void* where, const std::string& target);
+
+	// Shared by every intern, built once on first use
+	static FormRegistry& registry();
+	static FormRegistry defaultRegistry();
 
 public:
 	Intern();
@@ -34,6 +46,21 @@ public:
 	~Intern();
 
 	AForm* makeForm(const std::string& formName, const std::string& target) const;
+
+	// Same as makeForm, without printing anything; NULL for unknown names
+	AForm* createForm(const std::string& formName, const std::string& target) const;
+
+	// Builds the form inside the arena; it must not be deleted, the arena
+	// destroys it. Returns NULL for unknown names or when the arena is full.
+	AForm* makeForm(const std::string& formName, const std::string& target, FormArena& arena) const;
+
+	// Builds a whole batch at once, without printing anything. Replaces the
+	// previous content of batch; returns the number of forms created.
+	size_t makeForms(const std::vector<FormRequest>& requests, FormBatch& batch) const;
+
+	// Teach every intern a new form; false if the name is already known
+	static bool registerForm(const std::string& formName, FormCreator creator);
+	static bool registerForm(const std::string& formName, const FormType& type);
 };
 
 #endif
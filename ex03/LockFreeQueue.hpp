@@ -0,0 +1,140 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   LockFreeQueue.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/13 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/13 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef LOCKFREEQUEUE_HPP
+#define LOCKFREEQUEUE_HPP
+
+#include <cstddef>
+
+// Bounded multi-producer / multi-consumer queue (Vyukov's sequence-number
+// ring). Every cell carries a sequence number telling whether it is ready
+// to be written or read for a given lap, so producers and consumers only
+// race on their own index with a CAS and never take a lock.
+// C++98 has no <atomic>, so this relies on the GCC/Clang __atomic builtins.
+template <typename T>
+class LockFreeQueue
+{
+private:
+	struct Cell
+	{
+		size_t	sequence;
+		T		value;
+	};
+
+	// Keeps the producer and consumer indexes on separate cache lines
+	struct PaddedIndex
+	{
+		size_t	value;
+		char	pad[64 - sizeof(size_t)];
+	};
+
+	Cell*		cells;
+	size_t		mask;
+	PaddedIndex	tail;	// next cell to push
+	PaddedIndex	head;	// next cell to pop
+
+	LockFreeQueue(const LockFreeQueue& other);
+	LockFreeQueue& operator=(const LockFreeQueue& other);
+
+	static size_t roundUp(size_t n)
+	{
+		size_t size = 2;
+		while (size < n)
+			size <<= 1;
+		return size;
+	}
+
+public:
+	// Capacity is rounded up to a power of two
+	explicit LockFreeQueue(size_t capacity) : cells(NULL), mask(roundUp(capacity) - 1)
+	{
+		cells = new Cell[mask + 1];
+		for (size_t i = 0; i <= mask; i++)
+			cells[i].sequence = i;
+		tail.value = 0;
+		head.value = 0;
+	}
+
+	~LockFreeQueue()
+	{
+		delete[] cells;
+	}
+
+	// false when the queue is full
+	bool tryPush(const T& value)
+	{
+		size_t pos = __atomic_load_n(&tail.value, __ATOMIC_RELAXED);
+		Cell* cell;
+
+		for (;;)
+		{
+			cell = &cells[pos & mask];
+			size_t seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+			long diff = static_cast<long>(seq) - static_cast<long>(pos);
+			if (diff == 0)
+			{
+				if (__atomic_compare_exchange_n(&tail.value, &pos, pos + 1, true,
+						__ATOMIC_RELAXED, __ATOMIC_RELAXED))
+					break;
+			}
+			else if (diff < 0)
+				return false;
+			else
+				pos = __atomic_load_n(&tail.value, __ATOMIC_RELAXED);
+		}
+		cell->value = value;
+		__atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+		return true;
+	}
+
+	// false when the queue is empty
+	bool tryPop(T& value)
+	{
+		size_t pos = __atomic_load_n(&head.value, __ATOMIC_RELAXED);
+		Cell* cell;
+
+		for (;;)
+		{
+			cell = &cells[pos & mask];
+			size_t seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+			long diff = static_cast<long>(seq) - static_cast<long>(pos + 1);
+			if (diff == 0)
+			{
+				if (__atomic_compare_exchange_n(&head.value, &pos, pos + 1, true,
+						__ATOMIC_RELAXED, __ATOMIC_RELAXED))
+					break;
+			}
+			else if (diff < 0)
+				return false;
+			else
+				pos = __atomic_load_n(&head.value, __ATOMIC_RELAXED);
+		}
+		value = cell->value;
+		__atomic_store_n(&cell->sequence, pos + mask + 1, __ATOMIC_RELEASE);
+		return true;
+	}
+
+	// Approximate while other threads are pushing or popping
+	size_t size() const
+	{
+		size_t t = __atomic_load_n(&tail.value, __ATOMIC_RELAXED);
+		size_t h = __atomic_load_n(&head.value, __ATOMIC_RELAXED);
+		return t > h ? t - h : 0;
+	}
+
+	size_t capacity() const
+	{
+		return mask + 1;
+	}
+};
+
+#endif
@@ -0,0 +1,266 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   OutputRoot.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/12/01 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/12/01 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "OutputRoot.hpp"
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+OutputRoot::OutputRoot() : rootFd(-1), shardBits(0)
+{
+}
+
+OutputRoot::OutputRoot(const OutputRoot& other)
+	: ShrubberyOutput(), rootFd(-1), shardBits(0)
+{
+	(void)other;
+}
+
+OutputRoot& OutputRoot::operator=(const OutputRoot& other)
+{
+	(void)other;
+	return *this;
+}
+
+OutputRoot::~OutputRoot()
+{
+	close();
+}
+
+const char* OutputRoot::name() const
+{
+	return "root";
+}
+
+static bool makeDirectoryAt(int dirFd, const char* name)
+{
+	return mkdirat(dirFd, name, 0755) == 0 || errno == EEXIST;
+}
+
+bool OutputRoot::open(const std::string& path, unsigned int bits)
+{
+	close();
+	if (bits > MAX_SHARD_BITS)
+	{
+		errno = EINVAL;
+		return false;
+	}
+	if (!makeDirectoryAt(AT_FDCWD, path.c_str()))
+		return false;
+	rootFd = ::open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if (rootFd < 0)
+		return false;
+	rootPath = path;
+	shardBits = bits;
+	if (bits == 0)
+		return true;
+
+	shardFds.assign(static_cast<size_t>(1) << bits, -1);
+	for (size_t i = 0; i < shardFds.size(); i++)
+	{
+		std::string shard = shardName(i);
+		if (!makeDirectoryAt(rootFd, shard.c_str()))
+			break;
+		shardFds[i] = openat(rootFd, shard.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (shardFds[i] < 0)
+			break;
+	}
+	if (shardFds.back() >= 0)
+		return true;
+	int error = errno;
+	close();
+	errno = error;
+	return false;
+}
+
+void OutputRoot::close()
+{
+	for (size_t i = 0; i < shardFds.size(); i++)
+		if (shardFds[i] >= 0)
+			::close(shardFds[i]);
+	shardFds.clear();
+	if (rootFd >= 0)
+		::close(rootFd);
+	rootFd = -1;
+	rootPath.clear();
+	shardBits = 0;
+}
+
+bool OutputRoot::isOpen() const
+{
+	return rootFd >= 0;
+}
+
+size_t OutputRoot::shardCount() const
+{
+	return shardFds.size();
+}
+
+// FNV-1a; only the low shardBits bits are used
+unsigned int OutputRoot::hashName(const char* name)
+{
+	unsigned int hash = 2166136261U;
+
+	for (; *name; name++)
+	{
+		hash ^= static_cast<unsigned char>(*name);
+		hash *= 16777619U;
+	}
+	return hash;
+}
+
+std::string OutputRoot::shardName(size_t shard) const
+{
+	static const char digits[] = "0123456789abcdef";
+	std::string name((shardBits + 3) / 4, '0');
+
+	for (size_t i = name.size(); i-- > 0; shard >>= 4)
+		name[i] = digits[shard & 15];
+	return name;
+}
+
+int OutputRoot::directoryFor(const char* name, size_t* shard) const
+{
+	if (shardFds.empty())
+		return rootFd;
+	size_t index = hashName(name) & (shardFds.size() - 1);
+	if (shard)
+		*shard = index;
+	return shardFds[index];
+}
+
+int OutputRoot::openFile(const char* name, int flags, int mode) const
+{
+	if (rootFd < 0)
+	{
+		errno = EBADF;
+		return -1;
+	}
+	return openat(directoryFor(name, NULL), name, flags | O_CLOEXEC, mode);
+}
+
+bool OutputRoot::writeArt(const char* name, bool durable) const
+{
+	int fd = openFile(name, O_WRONLY | O_CREAT | O_TRUNC);
+
+	if (fd < 0)
+		return false;
+	const char* art = ShrubberyCreationForm::getArt();
+	size_t size = ShrubberyCreationForm::getArtSize();
+	size_t done = 0;
+	while (done < size)
+	{
+		ssize_t n = write(fd, art + done, size - done);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+		{
+			int saved = n < 0 ? errno : EIO;
+			::close(fd);
+			errno = saved;
+			return false;
+		}
+		done += n;
+	}
+	if (!durable)
+		return ::close(fd) == 0;
+	int error = closeDurablyAt(fd, directoryFor(name, NULL));
+	errno = error;
+	return error == 0;
+}
+
+bool OutputRoot::remove(const char* name) const
+{
+	if (rootFd < 0)
+	{
+		errno = EBADF;
+		return false;
+	}
+	return unlinkat(directoryFor(name, NULL), name, 0) == 0;
+}
+
+std::string OutputRoot::pathOf(const char* name) const
+{
+	size_t shard = 0;
+
+	directoryFor(name, &shard);
+	if (shardFds.empty())
+		return rootPath + "/" + name;
+	return rootPath + "/" + shardName(shard) + "/" + name;
+}
+
+// This root resolves names itself, whichever root executeAction uses
+std::string OutputRoot::pathFor(const ShrubberyCreationForm& form) const
+{
+	return form.getTarget() + "_shrubbery";
+}
+
+void OutputRoot::writeAll(const std::vector<std::string>& names, std::vector<int>& errors)
+{
+	errors.assign(names.size(), 0);
+	for (size_t i = 0; i < names.size(); i++)
+		if (!writeArt(names[i].c_str()))
+			errors[i] = errno;
+}
+
+// The directories are already open: fsync goes through the shard fds and
+// a group is one syncfs of the root, with no path walked at all
+void OutputRoot::makeDurable(const std::vector<std::string>& names, std::vector<int>& errors)
+{
+	DurabilityMode mode = getDurability().mode;
+
+	if (mode == DURABILITY_NONE)
+		return;
+	if (mode == DURABILITY_GROUP)
+	{
+#ifdef __linux__
+		int error = syncfs(rootFd) == 0 ? 0 : errno;
+#else
+		sync();
+		int error = 0;
+#endif
+		for (size_t i = 0; i < names.size(); i++)
+			if (errors[i] == 0)
+				errors[i] = error;
+		return;
+	}
+
+	std::vector<bool> touched(shardFds.empty() ? 1 : shardFds.size(), false);
+	for (size_t i = 0; i < names.size(); i++)
+	{
+		if (errors[i] != 0)
+			continue;
+		size_t shard = 0;
+		directoryFor(names[i].c_str(), &shard);
+		int fd = openFile(names[i].c_str(), O_RDONLY);
+		if (fd < 0 || fsync(fd) != 0)
+			errors[i] = errno;
+		if (fd >= 0)
+			::close(fd);
+		if (errors[i] == 0)
+			touched[shard] = true;
+	}
+	for (size_t s = 0; s < touched.size(); s++)
+	{
+		if (!touched[s] || fsync(shardFds.empty() ? rootFd : shardFds[s]) == 0)
+			continue;
+		int error = errno;
+		for (size_t i = 0; i < names.size(); i++)
+		{
+			size_t shard = 0;
+			directoryFor(names[i].c_str(), &shard);
+			if (errors[i] == 0 && shard == s)
+				errors[i] = error;
+		}
+	}
+}
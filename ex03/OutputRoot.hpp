@@ -0,0 +1,72 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   OutputRoot.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/12/01 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/12/01 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef OUTPUTROOT_HPP
+#define OUTPUTROOT_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "ShrubberyOutput.hpp"
+
+// An output directory held open: files are created with openat() relative
+// to it, so the kernel never walks the root's path again, however deep it
+// is. With shards, a file goes to one of 2^shardBits subdirectories
+// ("00".."ff" for 8 bits) picked by a hash of its name, which keeps each
+// directory small when there are millions of targets. open() creates the
+// root and every shard and keeps them all open, so a file costs one
+// openat and nothing is created lazily: the root can be shared by threads
+// once open() has returned.
+//
+// Names are file names ("home_shrubbery"); writeAll takes the same names
+// in place of paths. Set as ShrubberyCreationForm's output root, it also
+// receives the files of plain execute() calls.
+class OutputRoot : public ShrubberyOutput
+{
+public:
+	static const unsigned int	MAX_SHARD_BITS = 12;
+
+private:
+	int					rootFd;
+	std::string			rootPath;
+	unsigned int		shardBits;
+	std::vector<int>	shardFds;	// empty when not sharded
+
+	OutputRoot(const OutputRoot& other);
+	OutputRoot& operator=(const OutputRoot& other);
+
+	static unsigned int	hashName(const char* name);
+	int					directoryFor(const char* name, size_t* shard) const;
+	std::string			shardName(size_t shard) const;
+
+public:
+	OutputRoot();
+	~OutputRoot();
+
+	// false (errno set) if the root or a shard cannot be created or opened
+	bool		open(const std::string& path, unsigned int shardBits = 0);
+	void		close();
+	bool		isOpen() const;
+	size_t		shardCount() const;	// 0 when not sharded
+
+	int			openFile(const char* name, int flags, int mode = 0644) const;
+	bool		writeArt(const char* name, bool durable = false) const;	// as ShrubberyCreationForm::writeArt
+	bool		remove(const char* name) const;
+	std::string	pathOf(const char* name) const;	// for messages
+
+	std::string	pathFor(const ShrubberyCreationForm& form) const;	// the bare name
+	void		writeAll(const std::vector<std::string>& names, std::vector<int>& errors);
+	void		makeDurable(const std::vector<std::string>& names, std::vector<int>& errors);
+	const char*	name() const;
+};
+
+#endif
@@ -0,0 +1,127 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Random.cpp                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/25 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/25 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Random.hpp"
+#include <cstdlib>
+
+static inline unsigned long long rotl(unsigned long long x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+
+static unsigned long long xoshiroNext(unsigned long long* s)
+{
+	unsigned long long result = rotl(s[1] * 5, 7) * 9;
+	unsigned long long t = s[1] << 17;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rotl(s[3], 45);
+	return result;
+}
+
+// splitmix64 spreads (seed, stream) over the whole state, never all zero
+static void xoshiroSeed(unsigned long long* s, unsigned long long seed, unsigned long long stream)
+{
+	unsigned long long x = seed ^ (stream * 0xD1B54A32D192ED03ULL);
+
+	for (int i = 0; i < 4; i++)
+	{
+		x += 0x9E3779B97F4A7C15ULL;
+		unsigned long long z = x;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		s[i] = z ^ (z >> 31);
+	}
+}
+
+Xoshiro256::Xoshiro256()
+{
+	xoshiroSeed(state, 0, 0);
+}
+
+Xoshiro256::Xoshiro256(unsigned long long seed, unsigned long long stream)
+{
+	xoshiroSeed(state, seed, stream);
+}
+
+Xoshiro256::Xoshiro256(const Xoshiro256& other)
+{
+	*this = other;
+}
+
+Xoshiro256& Xoshiro256::operator=(const Xoshiro256& other)
+{
+	if (this != &other)
+	{
+		for (int i = 0; i < 4; i++)
+			state[i] = other.state[i];
+	}
+	return *this;
+}
+
+Xoshiro256::~Xoshiro256()
+{
+}
+
+void Xoshiro256::seed(unsigned long long seed, unsigned long long stream)
+{
+	xoshiroSeed(state, seed, stream);
+}
+
+unsigned long long Xoshiro256::next()
+{
+	return xoshiroNext(state);
+}
+
+// Run-wide seed; a new run bumps the generation so every thread reseeds
+static unsigned long long	g_seed = 0x5EED5EED5EED5EEDULL;
+static unsigned long		g_generation = 1;
+static unsigned long long	g_nextStream = 1;
+
+// __thread only takes plain data, hence no Xoshiro256 object here
+static __thread unsigned long long	t_state[4];
+static __thread unsigned long		t_generation = 0;
+
+void setRandomSeed(unsigned long long seed)
+{
+	__atomic_store_n(&g_seed, seed, __ATOMIC_RELAXED);
+	__atomic_store_n(&g_nextStream, 1, __ATOMIC_RELAXED);
+	__atomic_add_fetch(&g_generation, 1, __ATOMIC_RELEASE);
+	seedThreadRandom(0);
+}
+
+unsigned long long getRandomSeed()
+{
+	return __atomic_load_n(&g_seed, __ATOMIC_RELAXED);
+}
+
+void seedThreadRandom(unsigned long long stream)
+{
+	t_generation = __atomic_load_n(&g_generation, __ATOMIC_ACQUIRE);
+	xoshiroSeed(t_state, __atomic_load_n(&g_seed, __ATOMIC_RELAXED), stream);
+}
+
+unsigned long long threadRandom()
+{
+	if (t_generation != __atomic_load_n(&g_generation, __ATOMIC_ACQUIRE))
+		seedThreadRandom(__atomic_fetch_add(&g_nextStream, 1, __ATOMIC_RELAXED));
+	return xoshiroNext(t_state);
+}
+
+unsigned long long stdRandom()
+{
+	return static_cast<unsigned long long>(std::rand());
+}
@@ -0,0 +1,52 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Random.hpp                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/25 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/25 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+// Where random draws come from (see RobotomyRequestForm::setRandomSource)
+typedef unsigned long long (*RandomSource)();
+
+// xoshiro256** (Blackman & Vigna): 256 bits of state, a few shifts and
+// rotates per draw, and good enough statistics for a coin flip.
+class Xoshiro256
+{
+private:
+	unsigned long long	state[4];
+
+public:
+	Xoshiro256();
+	explicit Xoshiro256(unsigned long long seed, unsigned long long stream = 0);
+	Xoshiro256(const Xoshiro256& other);
+	Xoshiro256& operator=(const Xoshiro256& other);
+	~Xoshiro256();
+
+	// Same (seed, stream) pair, same sequence
+	void				seed(unsigned long long seed, unsigned long long stream = 0);
+	unsigned long long	next();
+};
+
+// Every thread draws from its own Xoshiro256, so there is no shared state
+// to fight over. setRandomSeed() starts a new run: the calling thread
+// restarts at stream 0, other threads pick the next free stream the next
+// time they draw. A single-threaded run replays exactly from its seed;
+// with several threads, call seedThreadRandom() in each worker to pin
+// its stream. The default seed is fixed.
+void				setRandomSeed(unsigned long long seed);
+unsigned long long	getRandomSeed();
+void				seedThreadRandom(unsigned long long stream);
+unsigned long long	threadRandom();
+
+// std::rand(), the pre-xoshiro behaviour (seed it with std::srand)
+unsigned long long	stdRandom();
+
+#endif
@@ -0,0 +1,164 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ReportFormat.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/12/03 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/12/03 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "ReportFormat.hpp"
+#include <cstring>
+
+// Appends the part of [data, data + length) that fits before size
+static size_t put(char* out, size_t size, size_t at, const char* data, size_t length)
+{
+	if (at < size)
+		std::memcpy(out + at, data, length < size - at ? length : size - at);
+	return at + length;
+}
+
+size_t formatInt(char* out, size_t size, int value)
+{
+	char digits[12];
+	char* end = digits + sizeof(digits);
+	char* p = end;
+	unsigned int magnitude = value < 0 ? 0U - static_cast<unsigned int>(value)
+		: static_cast<unsigned int>(value);
+
+	do
+	{
+		*--p = static_cast<char>('0' + magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude != 0);
+	if (value < 0)
+		*--p = '-';
+	size_t length = end - p;
+	if (length <= size)
+		std::memcpy(out, p, length);
+	return length;
+}
+
+// Writes the integer at `at` when it fits, returns where the line goes on
+static size_t putInt(char* out, size_t size, size_t at, int value)
+{
+	char digits[12];
+	size_t length = formatInt(digits, sizeof(digits), value);
+
+	return put(out, size, at, digits, length);
+}
+
+#define PUT_LITERAL(text)	at = put(out, size, at, text, sizeof(text) - 1)
+
+size_t formatForm(char* out, size_t size, const AForm& form)
+{
+	const std::string& name = form.getName();
+	size_t at = 0;
+
+	PUT_LITERAL("Form: ");
+	at = put(out, size, at, name.data(), name.size());
+	PUT_LITERAL(", grade to sign: ");
+	at = putInt(out, size, at, form.getGradeTosign());
+	PUT_LITERAL(", grade to execute: ");
+	at = putInt(out, size, at, form.getGradeToExecute());
+	PUT_LITERAL(", signed: ");
+	if (form.isFormSigned())
+		PUT_LITERAL("yes");
+	else
+		PUT_LITERAL("no");
+	return at;
+}
+
+size_t formatBureaucrat(char* out, size_t size, const Bureaucrat& bureaucrat)
+{
+	const std::string& name = bureaucrat.getName();
+	size_t at = 0;
+
+	at = put(out, size, at, name.data(), name.size());
+	PUT_LITERAL(", bureaucrat grade ");
+	return putInt(out, size, at, bureaucrat.getGrade());
+}
+
+#undef PUT_LITERAL
+
+/* ------------------------------------------------------------------------ */
+/*  ReportBuffer                                                             */
+/* ------------------------------------------------------------------------ */
+
+ReportBuffer::ReportBuffer(std::ostream& out, size_t capacity)
+	: buffer(new char[capacity ? capacity : 1]), capacity(capacity ? capacity : 1), used(0), out(out)
+{
+}
+
+ReportBuffer::ReportBuffer(const ReportBuffer& other)
+	: buffer(new char[other.capacity]), capacity(other.capacity), used(0), out(other.out)
+{
+}
+
+ReportBuffer& ReportBuffer::operator=(const ReportBuffer& other)
+{
+	(void)other;
+	return *this;
+}
+
+ReportBuffer::~ReportBuffer()
+{
+	flush();
+	delete[] buffer;
+}
+
+// A line is tried where the buffer ends; if it did not fit, once more in
+// an empty buffer, and streamed on its own when even that is too small
+template <typename T>
+void ReportBuffer::add(const T& item, size_t (*format)(char*, size_t, const T&))
+{
+	size_t length = format(buffer + used, capacity - used, item);
+
+	if (length >= capacity - used)
+	{
+		flush();
+		length = format(buffer, capacity, item);
+		if (length >= capacity)
+		{
+			out << item << '\n';
+			return;
+		}
+	}
+	used += length;
+	buffer[used++] = '\n';
+}
+
+void ReportBuffer::addForm(const AForm& form)
+{
+	add(form, &formatForm);
+}
+
+void ReportBuffer::addBureaucrat(const Bureaucrat& bureaucrat)
+{
+	add(bureaucrat, &formatBureaucrat);
+}
+
+void ReportBuffer::flush()
+{
+	if (used)
+		out.write(buffer, used);
+	used = 0;
+}
+
+void ReportBuffer::clear()
+{
+	used = 0;
+}
+
+const char* ReportBuffer::data() const
+{
+	return buffer;
+}
+
+size_t ReportBuffer::size() const
+{
+	return used;
+}
@@ -0,0 +1,62 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ReportFormat.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/12/03 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/12/03 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef REPORTFORMAT_HPP
+#define REPORTFORMAT_HPP
+
+#include <cstddef>
+#include <iostream>
+#include "AForm.hpp"
+#include "Bureaucrat.hpp"
+
+// The text of operator<< for forms and bureaucrats, written straight into
+// a char buffer: memcpy of the fixed parts and the name, digits converted
+// by hand, no stream and no std::string. The bytes are exactly those of
+// operator<< on a stream with default flags.
+//
+// Like snprintf, each function returns the length of the whole line and
+// writes it only if it fits in size bytes (no terminator is added).
+size_t	formatInt(char* out, size_t size, int value);
+size_t	formatForm(char* out, size_t size, const AForm& form);
+size_t	formatBureaucrat(char* out, size_t size, const Bureaucrat& bureaucrat);
+
+// A fixed buffer that report lines ('\n' after each) are appended to.
+// Allocates once, in the constructor; a line that does not fit flushes
+// the buffer to the stream first. A line longer than the whole buffer
+// goes through operator<< instead.
+class ReportBuffer
+{
+private:
+	char*			buffer;
+	size_t			capacity;
+	size_t			used;
+	std::ostream&	out;
+
+	ReportBuffer(const ReportBuffer& other);
+	ReportBuffer& operator=(const ReportBuffer& other);
+
+	template <typename T>
+	void	add(const T& item, size_t (*format)(char*, size_t, const T&));
+
+public:
+	ReportBuffer(std::ostream& out, size_t capacity = 64 * 1024);
+	~ReportBuffer();	// flushes
+
+	void		addForm(const AForm& form);
+	void		addBureaucrat(const Bureaucrat& bureaucrat);
+	void		flush();
+	void		clear();	// drops what is buffered
+	const char*	data() const;
+	size_t		size() const;
+};
+
+#endif
@@ -11,7 +11,11 @@
 /* ************************************************************************** */
 
 #include "RobotomyRequestForm.hpp"
+#include "Bureaucrat.hpp"
 #include <iostream>
+#include <cstring>
+
+RandomSource RobotomyRequestForm::randomSource = &threadRandom;
 
 RobotomyRequestForm::RobotomyRequestForm(const std::string& target)
 	: AForm("Robotomy Request", target, 72, 45)
@@ -39,8 +43,71 @@ void RobotomyRequestForm::executeAction() const
 	std::cout << "* BZZZZZZT! WHIRRRRR! DRRRRRR! *" << std::endl;
 	std::cout << "* Drilling noises... *" << std::endl;
 	
-	if (std::rand() % 2 == 0)
+	if (drawOutcome())
 		std::cout << getTarget() << " has been robotomized successfully!" << std::endl;
 	else
 		std::cout << "Robotomy on " << getTarget() << " failed!" << std::endl;
 }
+
+bool RobotomyRequestForm::drawOutcome()
+{
+	return randomSource() % 2 == 0;
+}
+
+void RobotomyRequestForm::setRandomSource(RandomSource source)
+{
+	randomSource = source ? source : &threadRandom;
+}
+
+RandomSource RobotomyRequestForm::getRandomSource()
+{
+	return randomSource;
+}
+
+// Byte k of the result is bit k of bits, as 0 or 1
+static inline unsigned long long spreadBits(unsigned long long bits)
+{
+	unsigned long long x = (bits & 0xFF) * 0x0101010101010101ULL;
+
+	x &= 0x8040201008040201ULL;
+	x += 0x7F7F7F7F7F7F7F7FULL;
+	return (x >> 7) & 0x0101010101010101ULL;
+}
+
+void RobotomyRequestForm::drawOutcomes(unsigned char* out, size_t count)
+{
+	if (randomSource != &threadRandom)
+	{
+		for (size_t i = 0; i < count; i++)
+			out[i] = drawOutcome() ? ROBOTOMY_SUCCEEDED : ROBOTOMY_FAILED;
+		return;
+	}
+	size_t i = 0;
+	while (i < count)
+	{
+		unsigned long long bits = threadRandom();
+		for (int byte = 0; byte < 8 && i < count; byte++, bits >>= 8)
+		{
+			unsigned long long spread = spreadBits(bits);
+			size_t n = count - i < 8 ? count - i : 8;
+			std::memcpy(out + i, &spread, n);	// big-endian only permutes them
+			i += n;
+		}
+	}
+}
+
+size_t RobotomyRequestForm::executeBatch(const RobotomyRequestForm* const* forms, size_t count,
+	const Bureaucrat& executor, unsigned char* outcomes)
+{
+	size_t successes = 0;
+
+	drawOutcomes(outcomes, count);
+	for (size_t i = 0; i < count; i++)
+	{
+		if (forms[i]->checkExecute(executor) != FORM_OK)
+			outcomes[i] = ROBOTOMY_REFUSED;
+		else
+			successes += outcomes[i];
+	}
+	return successes;
+}
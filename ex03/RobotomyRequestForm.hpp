@@ -14,11 +14,26 @@
 #define ROBOTOMYREQUESTFORM_HPP
 
 #include "AForm.hpp"
+#include "Random.hpp"
 #include <cstdlib>
+#include <cstddef>
 #include <string>
 
+class Bureaucrat;
+
+// One byte per form in a robotomy batch
+enum RobotomyOutcome
+{
+	ROBOTOMY_FAILED = 0,
+	ROBOTOMY_SUCCEEDED = 1,
+	ROBOTOMY_REFUSED = 2	// not signed, or executor grade too low
+};
+
 class RobotomyRequestForm : public AForm
 {
+private:
+	static RandomSource randomSource;
+
 protected:
 	virtual void executeAction() const;
 
@@ -27,6 +42,23 @@ public:
 	RobotomyRequestForm(const RobotomyRequestForm& other);
 	RobotomyRequestForm& operator=(const RobotomyRequestForm& other);
 	~RobotomyRequestForm();
+
+	// Heads or tails for one robotomy. Draws from threadRandom() unless
+	// another source is set; NULL restores it. Set it before any thread
+	// starts executing forms.
+	static bool drawOutcome();
+	static void setRandomSource(RandomSource source);
+	static RandomSource getRandomSource();
+
+	// count outcomes (ROBOTOMY_FAILED / ROBOTOMY_SUCCEEDED) into out. With
+	// the default source every 64-bit draw settles 64 robotomies, so the
+	// sequence differs from calling drawOutcome() count times.
+	static void drawOutcomes(unsigned char* out, size_t count);
+
+	// Executes count forms without printing: the checks of tryExecute,
+	// then one outcome per form into outcomes. Returns the successes.
+	static size_t executeBatch(const RobotomyRequestForm* const* forms, size_t count,
+		const Bureaucrat& executor, unsigned char* outcomes);
 };
 
 #endif
@@ -0,0 +1,165 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Roster.cpp                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/23 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/23 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Roster.hpp"
+
+Roster::Roster() : active(0)
+{
+	for (int w = 0; w < WORDS; w++)
+		used[w] = 0;
+}
+
+Roster::Roster(const Roster& other)
+{
+	*this = other;
+}
+
+Roster& Roster::operator=(const Roster& other)
+{
+	if (this != &other)
+	{
+		entries = other.entries;
+		for (int b = 0; b < BUCKETS; b++)
+			buckets[b] = other.buckets[b];
+		for (int w = 0; w < WORDS; w++)
+			used[w] = other.used[w];
+		active = other.active;
+	}
+	return *this;
+}
+
+Roster::~Roster()
+{
+}
+
+void Roster::link(size_t id)
+{
+	Entry& e = entries[id];
+
+	e.grade = e.bureaucrat->getGrade();
+	e.position = buckets[e.grade].size();
+	buckets[e.grade].push_back(id);
+	used[e.grade / 64] |= 1ULL << (e.grade % 64);
+	active++;
+}
+
+// Swap-and-pop out of its bucket, O(1)
+void Roster::unlink(size_t id)
+{
+	Entry& e = entries[id];
+
+	if (e.grade == 0)
+		return;
+	std::vector<size_t>& bucket = buckets[e.grade];
+	size_t last = bucket.back();
+	bucket[e.position] = last;
+	entries[last].position = e.position;
+	bucket.pop_back();
+	if (bucket.empty())
+		used[e.grade / 64] &= ~(1ULL << (e.grade % 64));
+	e.grade = 0;
+	active--;
+}
+
+size_t Roster::add(Bureaucrat& bureaucrat)
+{
+	Entry e;
+
+	e.bureaucrat = &bureaucrat;
+	e.grade = 0;
+	e.position = 0;
+	entries.push_back(e);
+	link(entries.size() - 1);
+	return entries.size() - 1;
+}
+
+void Roster::remove(size_t id)
+{
+	unlink(id);
+}
+
+void Roster::refresh(size_t id)
+{
+	Entry& e = entries[id];
+
+	if (e.grade != 0 && e.grade != e.bureaucrat->getGrade())
+	{
+		unlink(id);
+		link(id);
+	}
+}
+
+void Roster::promote(size_t id)
+{
+	entries[id].bureaucrat->incrementGrade();
+	refresh(id);
+}
+
+void Roster::demote(size_t id)
+{
+	entries[id].bureaucrat->decrementGrade();
+	refresh(id);
+}
+
+// Walks only the occupied buckets from 1 up to grade
+void Roster::atLeast(int grade, std::vector<size_t>& out) const
+{
+	out.clear();
+	if (grade < 1)
+		return;
+	if (grade > 150)
+		grade = 150;
+	for (int w = 0; w <= grade / 64; w++)
+	{
+		unsigned long long bits = used[w];
+		if (w == grade / 64 && grade % 64 != 63)
+			bits &= (1ULL << (grade % 64 + 1)) - 1;
+		while (bits)
+		{
+			int b = w * 64 + __builtin_ctzll(bits);
+			out.insert(out.end(), buckets[b].begin(), buckets[b].end());
+			bits &= bits - 1;
+		}
+	}
+}
+
+void Roster::signersFor(const AForm& form, std::vector<size_t>& out) const
+{
+	atLeast(form.getGradeTosign(), out);
+}
+
+void Roster::executorsFor(const AForm& form, std::vector<size_t>& out) const
+{
+	atLeast(form.getGradeToExecute(), out);
+}
+
+// Adds up bucket sizes without copying any ids
+size_t Roster::countAtLeast(int grade) const
+{
+	size_t count = 0;
+
+	if (grade > 150)
+		grade = 150;
+	for (int b = 1; b <= grade; b++)
+		count += buckets[b].size();
+	return count;
+}
+
+Bureaucrat& Roster::bureaucrat(size_t id) const
+{
+	return *entries[id].bureaucrat;
+}
+
+size_t Roster::size() const
+{
+	return active;
+}
@@ -0,0 +1,72 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Roster.hpp                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/23 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/23 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef ROSTER_HPP
+#define ROSTER_HPP
+
+#include <cstddef>
+#include <vector>
+#include "Bureaucrat.hpp"
+
+// Bureaucrats bucketed by grade, the mirror of FormIndex: given a form,
+// which bureaucrats may sign or execute it. Queries walk the occupied
+// buckets from grade 1 up to the form's grade, so they cost the size of
+// the answer. Change grades through promote/demote (or call refresh) so
+// the bureaucrat moves to its new bucket.
+class Roster
+{
+private:
+	static const int	BUCKETS = 151;	// grades 1..150, index = grade
+	static const int	WORDS = 3;
+
+	struct Entry
+	{
+		Bureaucrat*	bureaucrat;
+		int			grade;		// bucket it currently sits in, 0 if removed
+		size_t		position;
+	};
+
+	std::vector<Entry>	entries;
+	std::vector<size_t>	buckets[BUCKETS];
+	unsigned long long	used[WORDS];
+	size_t				active;
+
+	void	link(size_t id);
+	void	unlink(size_t id);
+
+public:
+	Roster();
+	Roster(const Roster& other);
+	Roster& operator=(const Roster& other);
+	~Roster();
+
+	// The roster does not own the bureaucrat; keep it alive while listed
+	size_t		add(Bureaucrat& bureaucrat);
+	void		remove(size_t id);
+	void		refresh(size_t id);	// re-read the grade after an outside change
+
+	// incrementGrade / decrementGrade, then move buckets. A throw leaves
+	// both the bureaucrat and the roster unchanged.
+	void		promote(size_t id);
+	void		demote(size_t id);
+
+	// Ids of the bureaucrats with grade <= grade
+	void		atLeast(int grade, std::vector<size_t>& out) const;
+	void		signersFor(const AForm& form, std::vector<size_t>& out) const;
+	void		executorsFor(const AForm& form, std::vector<size_t>& out) const;
+	size_t		countAtLeast(int grade) const;
+
+	Bureaucrat&	bureaucrat(size_t id) const;
+	size_t		size() const;	// bureaucrats currently listed
+};
+
+#endif
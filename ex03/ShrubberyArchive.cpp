@@ -0,0 +1,492 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ShrubberyArchive.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/28 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/28 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "ShrubberyArchive.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static const size_t	HEADER_SIZE = 3 * sizeof(unsigned int);
+static const size_t	TRAILER_SIZE = 5 * sizeof(unsigned long long);
+
+struct Trailer
+{
+	unsigned long long	magic;
+	unsigned long long	recordsEnd;		// the index starts 8-aligned after it
+	unsigned long long	indexOffset;
+	unsigned long long	slotCount;
+	unsigned long long	entries;
+};
+
+// Full read at an offset; false on error or end of file
+static bool readAt(int fd, void* out, size_t size, unsigned long long offset)
+{
+	char* to = static_cast<char*>(out);
+
+	while (size > 0)
+	{
+		ssize_t n = pread(fd, to, size, offset);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return false;
+		to += n;
+		size -= n;
+		offset += n;
+	}
+	return true;
+}
+
+static bool writeFully(int fd, const char* data, size_t size)
+{
+	while (size > 0)
+	{
+		ssize_t n = write(fd, data, size);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return false;
+		data += n;
+		size -= n;
+	}
+	return true;
+}
+
+/* ------------------------------------------------------------------------ */
+/*  ShrubberyArchive                                                         */
+/* ------------------------------------------------------------------------ */
+
+// FNV-1a, 64 bits; 0 is reserved for empty slots
+unsigned long long ShrubberyArchive::hashName(const char* name, size_t length)
+{
+	unsigned long long hash = 14695981039346656037ULL;
+
+	for (size_t i = 0; i < length; i++)
+	{
+		hash ^= static_cast<unsigned char>(name[i]);
+		hash *= 1099511628211ULL;
+	}
+	return hash ? hash : 1;
+}
+
+ShrubberyArchive::ShrubberyArchive() : fd(-1), flushed(0), entries(0)
+{
+}
+
+ShrubberyArchive::ShrubberyArchive(const ShrubberyArchive& other)
+	: ShrubberyOutput(), fd(-1), flushed(0), entries(0)
+{
+	(void)other;
+}
+
+ShrubberyArchive& ShrubberyArchive::operator=(const ShrubberyArchive& other)
+{
+	(void)other;
+	return *this;
+}
+
+ShrubberyArchive::~ShrubberyArchive()
+{
+	close();
+}
+
+bool ShrubberyArchive::isOpen() const
+{
+	return fd >= 0;
+}
+
+size_t ShrubberyArchive::size() const
+{
+	return entries;
+}
+
+const char* ShrubberyArchive::name() const
+{
+	return "archive";
+}
+
+// Empty, or starting with the record magic (possibly torn inside it).
+// Anything else is someone else's file, and rescan would truncate it.
+static bool startsLikeArchive(int fd, unsigned long long size)
+{
+	unsigned int magic = ShrubberyArchive::RECORD_MAGIC;
+	char head[sizeof(magic)];
+	size_t length = size < sizeof(magic) ? size : sizeof(magic);
+
+	return length == 0 || (readAt(fd, head, length, 0) && std::memcmp(head, &magic, length) == 0);
+}
+
+bool ShrubberyArchive::open(const std::string& path)
+{
+	struct stat info;
+
+	close();
+	fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+	if (fd < 0)
+		return false;
+	slots.assign(1024, Slot());
+	entries = 0;
+	buffer.clear();
+	buffer.reserve(BUFFER_SIZE);
+	bool opened = fstat(fd, &info) == 0;
+	if (opened && !startsLikeArchive(fd, info.st_size))
+	{
+		opened = false;
+		errno = EINVAL;
+	}
+	if (!opened || !(loadIndex(info.st_size) || rescan(info.st_size)))
+	{
+		int saved = errno;
+		::close(fd);
+		fd = -1;
+		errno = saved;
+		return false;
+	}
+	return true;
+}
+
+// A closed archive: take the index back, then cut it off
+bool ShrubberyArchive::loadIndex(unsigned long long size)
+{
+	Trailer trailer;
+
+	if (size < TRAILER_SIZE || !readAt(fd, &trailer, TRAILER_SIZE, size - TRAILER_SIZE)
+		|| trailer.magic != TRAILER_MAGIC || trailer.recordsEnd > trailer.indexOffset
+		|| trailer.indexOffset + trailer.slotCount * sizeof(Slot) + TRAILER_SIZE != size)
+		return false;
+
+	std::vector<Slot> stored(trailer.slotCount);
+	if (trailer.slotCount && !readAt(fd, &stored[0], trailer.slotCount * sizeof(Slot),
+			trailer.indexOffset))
+		return false;
+	if (ftruncate(fd, trailer.recordsEnd) != 0)
+		return false;
+	flushed = trailer.recordsEnd;
+	for (size_t i = 0; i < stored.size(); i++)
+		if (stored[i].hash != 0)
+			insert(stored[i].hash, stored[i].offset, NULL);
+	return true;
+}
+
+// No trailer: walk the records and keep every complete one
+bool ShrubberyArchive::rescan(unsigned long long size)
+{
+	unsigned long long offset = 0;
+	unsigned int header[3];
+	std::string name;
+
+	while (offset + HEADER_SIZE <= size && readAt(fd, header, HEADER_SIZE, offset)
+		&& header[0] == RECORD_MAGIC
+		&& offset + HEADER_SIZE + header[1] + header[2] <= size)
+	{
+		name.resize(header[1]);
+		if (header[1] && !readAt(fd, &name[0], header[1], offset + HEADER_SIZE))
+			break;
+		insert(hashName(name.data(), name.size()), offset, &name);
+		offset += HEADER_SIZE + header[1] + header[2];
+	}
+	if (offset != size && ftruncate(fd, offset) != 0)
+		return false;
+	flushed = offset;
+	return true;
+}
+
+// Does the record at offset carry this name? Only asked on a hash match.
+bool ShrubberyArchive::nameAt(unsigned long long offset, const std::string& name)
+{
+	unsigned int header[3];
+	std::string stored;
+
+	if (offset >= flushed && !flush())
+		return false;
+	if (!readAt(fd, header, HEADER_SIZE, offset) || header[1] != name.size())
+		return false;
+	stored.resize(header[1]);
+	return header[1] == 0 || (readAt(fd, &stored[0], header[1], offset + HEADER_SIZE)
+		&& stored == name);
+}
+
+// Open addressing, load factor at most 1/2. name is NULL when the offsets
+// come from a stored index, which holds each name once already.
+void ShrubberyArchive::insert(unsigned long long hash, unsigned long long offset,
+	const std::string* name)
+{
+	if ((entries + 1) * 2 > slots.size())
+	{
+		std::vector<Slot> old(slots);
+		slots.assign(old.size() * 2, Slot());
+		size_t mask = slots.size() - 1;
+		for (size_t i = 0; i < old.size(); i++)
+		{
+			if (old[i].hash == 0)
+				continue;
+			size_t j = old[i].hash & mask;
+			while (slots[j].hash != 0)
+				j = (j + 1) & mask;
+			slots[j] = old[i];
+		}
+	}
+
+	size_t mask = slots.size() - 1;
+	size_t i = hash & mask;
+	while (slots[i].hash != 0)
+	{
+		if (slots[i].hash == hash && name != NULL && nameAt(slots[i].offset, *name))
+		{
+			slots[i].offset = offset;	// newer record wins
+			return;
+		}
+		i = (i + 1) & mask;
+	}
+	slots[i].hash = hash;
+	slots[i].offset = offset;
+	entries++;
+}
+
+bool ShrubberyArchive::flush()
+{
+	if (buffer.empty())
+		return true;
+	if (!writeFully(fd, &buffer[0], buffer.size()))
+		return false;
+	flushed += buffer.size();
+	buffer.clear();
+	return true;
+}
+
+bool ShrubberyArchive::append(const std::string& name, const char* data, size_t size)
+{
+	if (fd < 0)
+	{
+		errno = EBADF;
+		return false;
+	}
+	size_t recordSize = HEADER_SIZE + name.size() + size;
+	if (buffer.size() + recordSize > BUFFER_SIZE && !flush())
+		return false;
+
+	unsigned long long offset = flushed + buffer.size();
+	unsigned int header[3] = { RECORD_MAGIC, static_cast<unsigned int>(name.size()),
+		static_cast<unsigned int>(size) };
+	const char* bytes = reinterpret_cast<const char*>(header);
+	buffer.insert(buffer.end(), bytes, bytes + HEADER_SIZE);
+	buffer.insert(buffer.end(), name.begin(), name.end());
+	buffer.insert(buffer.end(), data, data + size);
+	insert(hashName(name.data(), name.size()), offset, &name);
+	if (buffer.size() >= BUFFER_SIZE)
+		return flush();
+	return true;
+}
+
+bool ShrubberyArchive::close()
+{
+	if (fd < 0)
+		return true;
+
+	static const char zeros[8] = { 0 };
+	Trailer trailer;
+	bool done = flush();
+	size_t padding = (8 - flushed % 8) % 8;
+	trailer.magic = TRAILER_MAGIC;
+	trailer.recordsEnd = flushed;
+	trailer.indexOffset = flushed + padding;
+	trailer.slotCount = slots.size();
+	trailer.entries = entries;
+	done = done && writeFully(fd, zeros, padding);
+	done = done && writeFully(fd, reinterpret_cast<const char*>(&slots[0]),
+		slots.size() * sizeof(Slot));
+	done = done && writeFully(fd, reinterpret_cast<const char*>(&trailer), TRAILER_SIZE);
+
+	int saved = errno;
+	if (::close(fd) != 0)
+		done = false;
+	else
+		errno = saved;
+	fd = -1;
+	slots.clear();
+	buffer.clear();
+	entries = 0;
+	flushed = 0;
+	return done;
+}
+
+std::string ShrubberyArchive::pathFor(const ShrubberyCreationForm& form) const
+{
+	return form.getTarget() + "_shrubbery";
+}
+
+void ShrubberyArchive::writeAll(const std::vector<std::string>& paths, std::vector<int>& errors)
+{
+	const char* art = ShrubberyCreationForm::getArt();
+	size_t size = ShrubberyCreationForm::getArtSize();
+
+	errors.assign(paths.size(), 0);
+	for (size_t i = 0; i < paths.size(); i++)
+		if (!append(paths[i], art, size))
+			errors[i] = errno;
+	if (!flush())
+		for (size_t i = 0; i < paths.size(); i++)
+			errors[i] = errors[i] ? errors[i] : errno;
+}
+
+// The paths are names inside the archive: under any policy but NONE the
+// batch is one fdatasync of the segment, which writeAll already flushed
+void ShrubberyArchive::makeDurable(const std::vector<std::string>& paths, std::vector<int>& errors)
+{
+	if (getDurability().mode == DURABILITY_NONE || fd < 0 || fdatasync(fd) == 0)
+		return;
+	int error = errno;
+	for (size_t i = 0; i < paths.size(); i++)
+		if (errors[i] == 0)
+			errors[i] = error;
+}
+
+/* ------------------------------------------------------------------------ */
+/*  ShrubberyArchiveReader                                                   */
+/* ------------------------------------------------------------------------ */
+
+ShrubberyArchiveReader::ShrubberyArchiveReader()
+	: map(NULL), mapSize(0), slots(NULL), slotCount(0), entries(0), recordsEnd(0)
+{
+}
+
+ShrubberyArchiveReader::ShrubberyArchiveReader(const ShrubberyArchiveReader& other)
+	: map(NULL), mapSize(0), slots(NULL), slotCount(0), entries(0), recordsEnd(0)
+{
+	(void)other;
+}
+
+ShrubberyArchiveReader& ShrubberyArchiveReader::operator=(const ShrubberyArchiveReader& other)
+{
+	(void)other;
+	return *this;
+}
+
+ShrubberyArchiveReader::~ShrubberyArchiveReader()
+{
+	close();
+}
+
+bool ShrubberyArchiveReader::open(const std::string& path)
+{
+	struct stat info;
+	Trailer trailer;
+
+	close();
+	int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+	if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < TRAILER_SIZE)
+	{
+		::close(fd);
+		errno = EINVAL;
+		return false;
+	}
+	mapSize = info.st_size;
+	void* mapping = mmap(NULL, mapSize, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (mapping == MAP_FAILED)
+		return false;
+	map = static_cast<const char*>(mapping);
+
+	std::memcpy(&trailer, map + mapSize - TRAILER_SIZE, TRAILER_SIZE);
+	if (trailer.magic != ShrubberyArchive::TRAILER_MAGIC || trailer.slotCount == 0
+		|| trailer.recordsEnd > trailer.indexOffset
+		|| (trailer.slotCount & (trailer.slotCount - 1)) != 0
+		|| trailer.indexOffset % sizeof(unsigned long long) != 0
+		|| trailer.indexOffset + trailer.slotCount * sizeof(ShrubberyArchive::Slot)
+			+ TRAILER_SIZE != mapSize)
+	{
+		close();
+		errno = EINVAL;
+		return false;
+	}
+	slots = reinterpret_cast<const ShrubberyArchive::Slot*>(map + trailer.indexOffset);
+	slotCount = trailer.slotCount;
+	entries = trailer.entries;
+	recordsEnd = trailer.recordsEnd;
+	return true;
+}
+
+void ShrubberyArchiveReader::close()
+{
+	if (map != NULL)
+		munmap(const_cast<char*>(map), mapSize);
+	map = NULL;
+	mapSize = 0;
+	slots = NULL;
+	slotCount = 0;
+	entries = 0;
+	recordsEnd = 0;
+}
+
+size_t ShrubberyArchiveReader::size() const
+{
+	return entries;
+}
+
+bool ShrubberyArchiveReader::record(unsigned long long offset, const char*& name,
+	size_t& nameSize, const char*& data, size_t& dataSize) const
+{
+	unsigned int header[3];
+
+	if (offset + HEADER_SIZE > recordsEnd)
+		return false;
+	std::memcpy(header, map + offset, HEADER_SIZE);
+	if (header[0] != ShrubberyArchive::RECORD_MAGIC
+		|| offset + HEADER_SIZE + header[1] + header[2] > recordsEnd)
+		return false;
+	name = map + offset + HEADER_SIZE;
+	nameSize = header[1];
+	data = name + nameSize;
+	dataSize = header[2];
+	return true;
+}
+
+bool ShrubberyArchiveReader::find(const std::string& name, const char*& data, size_t& size) const
+{
+	if (map == NULL)
+		return false;
+
+	unsigned long long hash = ShrubberyArchive::hashName(name.data(), name.size());
+	size_t mask = slotCount - 1;
+	size_t i = hash & mask;
+	const char* storedName;
+	size_t storedSize;
+
+	for (size_t probes = 0; probes < slotCount && slots[i].hash != 0; probes++)
+	{
+		if (slots[i].hash == hash
+			&& record(slots[i].offset, storedName, storedSize, data, size)
+			&& storedSize == name.size()
+			&& std::memcmp(storedName, name.data(), storedSize) == 0)
+			return true;
+		i = (i + 1) & mask;
+	}
+	return false;
+}
+
+void ShrubberyArchiveReader::names(std::vector<std::string>& out) const
+{
+	const char* name;
+	size_t nameSize;
+	const char* data;
+	size_t dataSize;
+
+	out.clear();
+	for (size_t i = 0; i < slotCount; i++)
+		if (slots[i].hash != 0 && record(slots[i].offset, name, nameSize, data, dataSize))
+			out.push_back(std::string(name, nameSize));
+}
@@ -0,0 +1,118 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ShrubberyArchive.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/28 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/28 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SHRUBBERYARCHIVE_HPP
+#define SHRUBBERYARCHIVE_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "ShrubberyOutput.hpp"
+
+// Archive mode: every shrubbery goes into one append-only segment file
+// instead of its own <target>_shrubbery file. Entries are keyed by the
+// name the file would have had ("home_shrubbery"); appending a name again
+// replaces the entry. close() writes a hash index and a trailer after the
+// records, which is what lets ShrubberyArchiveReader find a name in O(1).
+//
+// Layout, host byte order:
+//   record   u32 magic, u32 name length, u32 data length, name, data
+//   index    8-aligned power-of-two table of { u64 hash (0 = empty), u64 offset }
+//   trailer  u64 magic, u64 end of records, u64 index offset, u64 slot count,
+//            u64 entry count
+//
+// open() on an existing archive drops its index and appends after the
+// last record. An archive without a trailer (the writer died) is
+// rescanned record by record and cut after the last complete one. A file
+// that does not start with RECORD_MAGIC is not an archive: open() leaves
+// it alone and fails with EINVAL.
+class ShrubberyArchive : public ShrubberyOutput
+{
+public:
+	struct Slot
+	{
+		unsigned long long	hash;
+		unsigned long long	offset;
+	};
+
+	static const unsigned int		RECORD_MAGIC = 0x42524853;			// "SHRB"
+	static const unsigned long long	TRAILER_MAGIC = 0x3158444942524853ULL;	// "SHRBIDX1"
+	static const size_t				BUFFER_SIZE = 64 * 1024;
+
+	static unsigned long long	hashName(const char* name, size_t length);
+
+private:
+	int						fd;
+	std::vector<char>		buffer;		// records not written yet
+	unsigned long long		flushed;	// file size on disk
+	std::vector<Slot>		slots;
+	size_t					entries;
+
+	ShrubberyArchive(const ShrubberyArchive& other);
+	ShrubberyArchive& operator=(const ShrubberyArchive& other);
+
+	bool	flush();
+	bool	loadIndex(unsigned long long size);
+	bool	rescan(unsigned long long size);
+	bool	nameAt(unsigned long long offset, const std::string& name);
+	void	insert(unsigned long long hash, unsigned long long offset, const std::string* name);
+
+public:
+	ShrubberyArchive();
+	~ShrubberyArchive();	// closes (and indexes) the archive if still open
+
+	bool	open(const std::string& path);	// false (errno) on failure
+	bool	append(const std::string& name, const char* data, size_t size);
+	bool	close();	// flushes, writes index and trailer; false (errno) on failure
+	bool	isOpen() const;
+	size_t	size() const;	// distinct names
+
+	// Entries keep the plain name even with an output root set
+	std::string	pathFor(const ShrubberyCreationForm& form) const;
+	// Appends the art under each path; indexed once close() runs
+	void		writeAll(const std::vector<std::string>& paths, std::vector<int>& errors);
+	void		makeDurable(const std::vector<std::string>& paths, std::vector<int>& errors);
+	const char*	name() const;
+};
+
+// Maps a closed archive read-only. find() hashes the name and probes the
+// stored table, so a lookup touches one or two slots and one record.
+class ShrubberyArchiveReader
+{
+private:
+	const char*	map;
+	size_t		mapSize;
+	const ShrubberyArchive::Slot*	slots;
+	size_t		slotCount;
+	size_t		entries;
+	unsigned long long	recordsEnd;
+
+	ShrubberyArchiveReader(const ShrubberyArchiveReader& other);
+	ShrubberyArchiveReader& operator=(const ShrubberyArchiveReader& other);
+
+	bool	record(unsigned long long offset, const char*& name, size_t& nameSize,
+				const char*& data, size_t& dataSize) const;
+
+public:
+	ShrubberyArchiveReader();
+	~ShrubberyArchiveReader();
+
+	bool	open(const std::string& path);	// false if missing, torn or not an archive
+	void	close();
+	size_t	size() const;
+
+	// data points into the mapping, valid until close()
+	bool	find(const std::string& name, const char*& data, size_t& size) const;
+	void	names(std::vector<std::string>& out) const;
+};
+
+#endif
@@ -11,6 +11,14 @@
 /* ************************************************************************** */
 
 #include "ShrubberyCreationForm.hpp"
+#include "Durability.hpp"
+#include "OutputRoot.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+const OutputRoot* ShrubberyCreationForm::outputRoot = NULL;
 
 ShrubberyCreationForm::ShrubberyCreationForm(const std::string& target)
 	: AForm("Shrubbery Creation", target, 145, 137)
@@ -33,36 +41,96 @@ ShrubberyCreationForm::~ShrubberyCreationForm()
 {
 }
 
+#define TREE \
+	"       _-_\n" \
+	"    /~~   ~~\\\n" \
+	" /~~         ~~\\\n" \
+	"{               }\n" \
+	" \\  _-     -_  /\n" \
+	"   ~  \\\\ //  ~\n" \
+	"_- -   | | _- _\n" \
+	"  _ -  | |   -_\n" \
+	"      // \\\\\n"
+
+static const char	g_art[] = TREE "\n" TREE;
+
+#undef TREE
+
+const char* ShrubberyCreationForm::getArt()
+{
+	return g_art;
+}
+
+size_t ShrubberyCreationForm::getArtSize()
+{
+	return sizeof(g_art) - 1;
+}
+
+bool ShrubberyCreationForm::writeArt(const char* path, bool durable)
+{
+	int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+	if (fd < 0)
+		return false;
+	size_t done = 0;
+	while (done < getArtSize())
+	{
+		ssize_t n = write(fd, g_art + done, getArtSize() - done);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+		{
+			int saved = n < 0 ? errno : EIO;
+			close(fd);
+			errno = saved;
+			return false;
+		}
+		done += n;
+	}
+	if (!durable)
+		return close(fd) == 0;
+	int error = closeDurably(fd, path);
+	errno = error;
+	return error == 0;
+}
+
 void ShrubberyCreationForm::executeAction() const
 {
 	std::string filename = getTarget() + "_shrubbery";
-	std::ofstream file(filename.c_str());
-	
-	if (!file.is_open())
+
+	if (outputRoot == NULL)
 	{
-		std::cerr << "Error: Could not create file " << filename << std::endl;
-		return;
+		if (!writeArt(filename.c_str(), true))
+			throw FileCreationException(filename, errno);
 	}
-	
-	file << "       _-_\n";
-	file << "    /~~   ~~\\\n";
-	file << " /~~         ~~\\\n";
-	file << "{               }\n";
-	file << " \\  _-     -_  /\n";
-	file << "   ~  \\\\ //  ~\n";
-	file << "_- -   | | _- _\n";
-	file << "  _ -  | |   -_\n";
-	file << "      // \\\\\n";
-	file << "\n";
-	file << "       _-_\n";
-	file << "    /~~   ~~\\\n";
-	file << " /~~         ~~\\\n";
-	file << "{               }\n";
-	file << " \\  _-     -_  /\n";
-	file << "   ~  \\\\ //  ~\n";
-	file << "_- -   | | _- _\n";
-	file << "  _ -  | |   -_\n";
-	file << "      // \\\\\n";
-	
-	file.close();
+	else if (!outputRoot->writeArt(filename.c_str(), true))
+	{
+		int error = errno;	// before pathOf allocates
+		throw FileCreationException(outputRoot->pathOf(filename.c_str()), error);
+	}
+}
+
+void ShrubberyCreationForm::setOutputRoot(const OutputRoot* root)
+{
+	outputRoot = root;
+}
+
+const OutputRoot* ShrubberyCreationForm::getOutputRoot()
+{
+	return outputRoot;
+}
+
+ShrubberyCreationForm::FileCreationException::FileCreationException(const std::string& path,
+	int error)
+	: message("Could not create file " + path + ": " + std::strerror(error))
+{
+}
+
+ShrubberyCreationForm::FileCreationException::~FileCreationException() throw()
+{
+}
+
+const char* ShrubberyCreationForm::FileCreationException::what() const throw()
+{
+	return message.c_str();
 }
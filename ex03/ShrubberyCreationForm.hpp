@@ -16,9 +16,15 @@
 #include "AForm.hpp"
 #include <fstream>
 #include <string>
+#include <cstddef>
+
+class OutputRoot;
 
 class ShrubberyCreationForm : public AForm
 {
+private:
+	static const OutputRoot*	outputRoot;
+
 protected:
 	virtual void executeAction() const;
 
@@ -30,6 +36,31 @@ public:
 	ShrubberyCreationForm(const ShrubberyCreationForm& other);
 	ShrubberyCreationForm& operator=(const ShrubberyCreationForm& other);
 	~ShrubberyCreationForm();
+
+	// The two trees every file gets, rendered once at compile time
+	static const char*	getArt();
+	static size_t		getArtSize();
+
+	// One open/write/close, no iostream; false (errno set) on failure.
+	// durable waits for the durability policy (Durability.hpp) as well.
+	static bool			writeArt(const char* path, bool durable = false);
+
+	// Where executeAction creates <target>_shrubbery: the current directory
+	// unless an open OutputRoot is set; NULL goes back to it. Set it before
+	// any thread starts executing forms.
+	static void					setOutputRoot(const OutputRoot* root);
+	static const OutputRoot*	getOutputRoot();
+	// Thrown by executeAction when the file cannot be written or made
+	// durable; what() names the file and strerror of the cause
+	class FileCreationException : public std::exception
+	{
+		private:
+			std::string	message;
+		public:
+			FileCreationException(const std::string& path, int error);
+			~FileCreationException() throw();
+			const char* what() const throw();
+	};
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,489 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ShrubberyOutput.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/27 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/27 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "ShrubberyOutput.hpp"
+#include "OutputRoot.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(__has_include)
+# if __has_include(<linux/io_uring.h>)
+#  include <linux/io_uring.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  if defined(IORING_FEAT_CQE_SKIP) && defined(__NR_io_uring_setup)
+#   define HAVE_URING 1
+#  endif
+# endif
+#endif
+
+/* ------------------------------------------------------------------------ */
+/*  ShrubberyOutput                                                          */
+/* ------------------------------------------------------------------------ */
+
+ShrubberyOutput::~ShrubberyOutput()
+{
+}
+
+void ShrubberyOutput::makeDurable(const std::vector<std::string>& paths, std::vector<int>& errors)
+{
+	syncFiles(paths, errors);
+}
+
+std::string ShrubberyOutput::pathFor(const ShrubberyCreationForm& form) const
+{
+	const OutputRoot* root = ShrubberyCreationForm::getOutputRoot();
+	std::string name = form.getTarget() + "_shrubbery";
+
+	return root == NULL ? name : root->pathOf(name.c_str());
+}
+
+size_t ShrubberyOutput::execute(const ShrubberyCreationForm* const* forms, size_t count,
+	const Bureaucrat& executor, FormExecutor::Result* results)
+{
+	std::vector<std::string> paths;
+	std::vector<size_t> owners;
+	std::vector<int> errors;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		results[i].status = forms[i]->checkExecute(executor);
+		results[i].actionFailed = false;
+		results[i].error.clear();
+		results[i].latencyNs = 0;
+		if (results[i].status == FORM_OK)
+		{
+			paths.push_back(pathFor(*forms[i]));
+			owners.push_back(i);
+		}
+	}
+
+	double start = FormExecutor::now();
+	writeAll(paths, errors);
+	makeDurable(paths, errors);
+	double elapsed = FormExecutor::now() - start;
+
+	size_t written = 0;
+	for (size_t k = 0; k < paths.size(); k++)
+	{
+		FormExecutor::Result& result = results[owners[k]];
+		result.latencyNs = elapsed;
+		if (errors[k] == 0)
+			written++;
+		else
+		{
+			result.actionFailed = true;
+			result.error = "Could not create file " + paths[k] + ": " + std::strerror(errors[k]);
+		}
+	}
+	return written;
+}
+
+ShrubberyOutput* ShrubberyOutput::create(int threads)
+{
+	ShrubberyOutput* output = UringShrubberyOutput::tryCreate();
+
+	if (output == NULL)
+		output = new PoolShrubberyOutput(threads);
+	return output;
+}
+
+/* ------------------------------------------------------------------------ */
+/*  PoolShrubberyOutput                                                      */
+/* ------------------------------------------------------------------------ */
+
+static int pwriteArt(const char* path)
+{
+	const char* art = ShrubberyCreationForm::getArt();
+	size_t size = ShrubberyCreationForm::getArtSize();
+	int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+	if (fd < 0)
+		return errno;
+	size_t done = 0;
+	while (done < size)
+	{
+		ssize_t n = pwrite(fd, art + done, size - done, done);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+		{
+			int error = n < 0 ? errno : EIO;
+			close(fd);
+			return error;
+		}
+		done += n;
+	}
+	return close(fd) == 0 ? 0 : errno;
+}
+
+PoolShrubberyOutput::PoolShrubberyOutput(int threads)
+	: threads(threads < 1 ? 1 : threads)
+{
+	start();
+}
+
+PoolShrubberyOutput::PoolShrubberyOutput(const PoolShrubberyOutput& other)
+	: ShrubberyOutput(), threads(other.threads)
+{
+	start();
+}
+
+PoolShrubberyOutput& PoolShrubberyOutput::operator=(const PoolShrubberyOutput& other)
+{
+	if (this != &other)
+	{
+		stop();
+		threads = other.threads;
+		start();
+	}
+	return *this;
+}
+
+PoolShrubberyOutput::~PoolShrubberyOutput()
+{
+	stop();
+}
+
+void PoolShrubberyOutput::start()
+{
+	pthread_mutex_init(&lock, NULL);
+	pthread_cond_init(&batchReady, NULL);
+	pthread_cond_init(&batchDone, NULL);
+	batchPaths = NULL;
+	batchErrors = NULL;
+	next = 0;
+	batch = 0;
+	finished = 0;
+	stopping = false;
+	for (int t = 0; t < threads; t++)
+	{
+		pthread_t thread;
+		if (pthread_create(&thread, NULL, &PoolShrubberyOutput::workerMain, this) == 0)
+			workers.push_back(thread);
+	}
+}
+
+void PoolShrubberyOutput::stop()
+{
+	pthread_mutex_lock(&lock);
+	stopping = true;
+	pthread_cond_broadcast(&batchReady);
+	pthread_mutex_unlock(&lock);
+	for (size_t t = 0; t < workers.size(); t++)
+		pthread_join(workers[t], NULL);
+	workers.clear();
+	pthread_cond_destroy(&batchDone);
+	pthread_cond_destroy(&batchReady);
+	pthread_mutex_destroy(&lock);
+}
+
+void PoolShrubberyOutput::claimPaths()
+{
+	size_t count = batchPaths->size();
+	size_t i;
+
+	while ((i = __atomic_fetch_add(&next, 1, __ATOMIC_RELAXED)) < count)
+		(*batchErrors)[i] = pwriteArt((*batchPaths)[i].c_str());
+}
+
+void* PoolShrubberyOutput::workerMain(void* arg)
+{
+	PoolShrubberyOutput* pool = static_cast<PoolShrubberyOutput*>(arg);
+	unsigned long seen = 0;
+
+	pthread_mutex_lock(&pool->lock);
+	for (;;)
+	{
+		while (pool->batch == seen && !pool->stopping)
+			pthread_cond_wait(&pool->batchReady, &pool->lock);
+		if (pool->stopping)
+			break;
+		seen = pool->batch;
+		pthread_mutex_unlock(&pool->lock);
+		pool->claimPaths();
+		pthread_mutex_lock(&pool->lock);
+		if (++pool->finished == pool->workers.size())
+			pthread_cond_signal(&pool->batchDone);
+	}
+	pthread_mutex_unlock(&pool->lock);
+	return NULL;
+}
+
+// Every started worker takes part in every batch, so writeAll returns
+// only once none of them can still touch paths or errors
+void PoolShrubberyOutput::writeAll(const std::vector<std::string>& paths, std::vector<int>& errors)
+{
+	errors.assign(paths.size(), 0);
+	pthread_mutex_lock(&lock);
+	batchPaths = &paths;
+	batchErrors = &errors;
+	next = 0;
+	finished = 0;
+	batch++;
+	pthread_cond_broadcast(&batchReady);
+	pthread_mutex_unlock(&lock);
+
+	claimPaths();
+
+	pthread_mutex_lock(&lock);
+	while (finished < workers.size())
+		pthread_cond_wait(&batchDone, &lock);
+	batchPaths = NULL;
+	batchErrors = NULL;
+	pthread_mutex_unlock(&lock);
+}
+
+const char* PoolShrubberyOutput::name() const
+{
+	return "thread pool";
+}
+
+/* ------------------------------------------------------------------------ */
+/*  UringShrubberyOutput                                                     */
+/* ------------------------------------------------------------------------ */
+
+UringShrubberyOutput::UringShrubberyOutput()
+	: ringFd(-1), ring(NULL), ringSize(0), sqes(NULL), sqesSize(0), sqTail(NULL), sqMask(0),
+	  sqArray(NULL), cqHead(NULL), cqTail(NULL), cqMask(0), cqes(NULL), slots(0)
+{
+}
+
+UringShrubberyOutput::UringShrubberyOutput(const UringShrubberyOutput& other)
+	: ShrubberyOutput(), ringFd(-1), ring(NULL), ringSize(0), sqes(NULL), sqesSize(0),
+	  sqTail(NULL), sqMask(0), sqArray(NULL), cqHead(NULL), cqTail(NULL), cqMask(0),
+	  cqes(NULL), slots(0)
+{
+	(void)other;
+}
+
+UringShrubberyOutput& UringShrubberyOutput::operator=(const UringShrubberyOutput& other)
+{
+	(void)other;
+	return *this;
+}
+
+const char* UringShrubberyOutput::name() const
+{
+	return "io_uring";
+}
+
+#ifdef HAVE_URING
+
+UringShrubberyOutput::~UringShrubberyOutput()
+{
+	if (sqes != NULL)
+		munmap(sqes, sqesSize);
+	if (ring != NULL)
+		munmap(ring, ringSize);
+	if (ringFd >= 0)
+		close(ringFd);
+}
+
+UringShrubberyOutput* UringShrubberyOutput::tryCreate(unsigned filesInFlight)
+{
+	UringShrubberyOutput* output = new UringShrubberyOutput();
+
+	if (!output->setup(filesInFlight * 3))
+	{
+		delete output;
+		return NULL;
+	}
+	return output;
+}
+
+bool UringShrubberyOutput::setup(unsigned entries)
+{
+	struct io_uring_params params;
+
+	std::memset(&params, 0, sizeof(params));
+	ringFd = syscall(__NR_io_uring_setup, entries, &params);
+	if (ringFd < 0)
+		return false;
+	// CQE_SKIP arrived in 5.17, after openat/close on direct descriptors
+	if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !(params.features & IORING_FEAT_CQE_SKIP))
+		return false;
+
+	size_t sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+	size_t cqSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	ringSize = sqSize > cqSize ? sqSize : cqSize;
+	ring = mmap(NULL, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+		ringFd, IORING_OFF_SQ_RING);
+	if (ring == MAP_FAILED)
+	{
+		ring = NULL;
+		return false;
+	}
+	sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+	sqes = mmap(NULL, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+		ringFd, IORING_OFF_SQES);
+	if (sqes == MAP_FAILED)
+	{
+		sqes = NULL;
+		return false;
+	}
+
+	char* base = static_cast<char*>(ring);
+	sqTail = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+	sqMask = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+	sqArray = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+	cqHead = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+	cqTail = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+	cqMask = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+	cqes = base + params.cq_off.cqes;
+
+	// Empty fixed-file table: openat fills a slot, close empties it
+	slots = params.sq_entries / 3;
+	std::vector<int> table(slots, -1);
+	return syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_FILES, &table[0], slots) == 0;
+}
+
+// user_data is file index * 4 + step (0 open, 1 write, 2 close). The
+// first failure of a chain wins; the steps after it report -ECANCELED.
+void UringShrubberyOutput::reap(std::vector<int>& errors, size_t base,
+	std::vector<unsigned char>& steps, size_t& reaped)
+{
+	unsigned head = *cqHead;
+	unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+	struct io_uring_cqe* entries = static_cast<struct io_uring_cqe*>(cqes);
+
+	while (head != tail)
+	{
+		const struct io_uring_cqe& cqe = entries[head & cqMask];
+		size_t file = cqe.user_data >> 2;
+		int step = cqe.user_data & 3;
+		int error = 0;
+
+		if (cqe.res < 0)
+			error = -cqe.res;
+		else if (step == 1 && static_cast<size_t>(cqe.res) != ShrubberyCreationForm::getArtSize())
+			error = EIO;
+		if (error && (errors[file] == 0 || errors[file] == ECANCELED))
+			errors[file] = error;
+		steps[file - base]++;
+		head++;
+		reaped++;
+	}
+	__atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+}
+
+void UringShrubberyOutput::writeAll(const std::vector<std::string>& paths, std::vector<int>& errors)
+{
+	struct io_uring_sqe* entries = static_cast<struct io_uring_sqe*>(sqes);
+	const char* art = ShrubberyCreationForm::getArt();
+	size_t count = paths.size();
+
+	errors.assign(count, 0);
+	for (size_t base = 0; base < count; base += slots)
+	{
+		size_t window = count - base < slots ? count - base : slots;
+		unsigned tail = *sqTail;
+
+		for (size_t k = 0; k < window; k++)
+		{
+			size_t file = base + k;
+			struct io_uring_sqe* openSqe = &entries[tail & sqMask];
+			struct io_uring_sqe* writeSqe = &entries[(tail + 1) & sqMask];
+			struct io_uring_sqe* closeSqe = &entries[(tail + 2) & sqMask];
+
+			std::memset(openSqe, 0, sizeof(*openSqe));
+			std::memset(writeSqe, 0, sizeof(*writeSqe));
+			std::memset(closeSqe, 0, sizeof(*closeSqe));
+
+			openSqe->opcode = IORING_OP_OPENAT;
+			openSqe->fd = AT_FDCWD;
+			openSqe->addr = reinterpret_cast<unsigned long>(paths[file].c_str());
+			openSqe->len = 0644;
+			// No O_CLOEXEC: a direct descriptor is never in the fd table
+			openSqe->open_flags = O_WRONLY | O_CREAT | O_TRUNC;
+			openSqe->file_index = k + 1;
+			openSqe->flags = IOSQE_IO_LINK;
+			openSqe->user_data = file << 2;
+
+			// Hard link: the slot is closed even if the write fails
+			writeSqe->opcode = IORING_OP_WRITE;
+			writeSqe->fd = k;
+			writeSqe->addr = reinterpret_cast<unsigned long>(art);
+			writeSqe->len = ShrubberyCreationForm::getArtSize();
+			writeSqe->off = 0;
+			writeSqe->flags = IOSQE_FIXED_FILE | IOSQE_IO_HARDLINK;
+			writeSqe->user_data = (file << 2) | 1;
+
+			closeSqe->opcode = IORING_OP_CLOSE;
+			closeSqe->file_index = k + 1;
+			closeSqe->user_data = (file << 2) | 2;
+
+			for (int step = 0; step < 3; step++, tail++)
+				sqArray[tail & sqMask] = tail & sqMask;
+		}
+		__atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+
+		std::vector<unsigned char> steps(window, 0);
+		size_t pending = window * 3;
+		size_t toSubmit = pending;
+		size_t reaped = 0;
+		while (reaped < pending)
+		{
+			long done = syscall(__NR_io_uring_enter, ringFd, toSubmit, 1,
+				IORING_ENTER_GETEVENTS, NULL, 0);
+			if (done < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+			{
+				// The ring is unusable; report every unfinished file
+				int error = errno;
+				for (size_t k = base; k < count; k++)
+					if (k >= base + window || (steps[k - base] < 3 && errors[k] == 0))
+						errors[k] = error;
+				return;
+			}
+			if (done > 0)
+				toSubmit -= static_cast<size_t>(done) < toSubmit ? done : toSubmit;
+			reap(errors, base, steps, reaped);
+		}
+	}
+}
+
+#else
+
+UringShrubberyOutput::~UringShrubberyOutput()
+{
+}
+
+UringShrubberyOutput* UringShrubberyOutput::tryCreate(unsigned filesInFlight)
+{
+	(void)filesInFlight;
+	return NULL;
+}
+
+bool UringShrubberyOutput::setup(unsigned entries)
+{
+	(void)entries;
+	return false;
+}
+
+void UringShrubberyOutput::reap(std::vector<int>& errors, size_t base,
+	std::vector<unsigned char>& steps, size_t& reaped)
+{
+	(void)errors;
+	(void)base;
+	(void)steps;
+	(void)reaped;
+}
+
+void UringShrubberyOutput::writeAll(const std::vector<std::string>& paths, std::vector<int>& errors)
+{
+	errors.assign(paths.size(), ENOSYS);
+}
+
+#endif
@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ShrubberyOutput.hpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/27 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/27 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SHRUBBERYOUTPUT_HPP
+#define SHRUBBERYOUTPUT_HPP
+
+#include <cstddef>
+#include <pthread.h>
+#include <string>
+#include <vector>
+#include "ShrubberyCreationForm.hpp"
+#include "Bureaucrat.hpp"
+#include "FormExecutor.hpp"
+#include "Durability.hpp"
+
+// Writes the shrubbery art for many targets in one call, instead of one
+// blocking open/write/close per executeAction. execute() runs the
+// tryExecute checks, hands every allowed file to the backend at once and
+// maps each file's result back to its form.
+class ShrubberyOutput
+{
+public:
+	virtual ~ShrubberyOutput();
+
+	// errors[i] is 0 once paths[i] holds the art, or the errno that stopped it
+	virtual void		writeAll(const std::vector<std::string>& paths,
+							std::vector<int>& errors) = 0;
+	virtual const char*	name() const = 0;
+
+	// Applies the durability policy to the files writeAll just wrote;
+	// by default syncFiles() (Durability.hpp)
+	virtual void		makeDurable(const std::vector<std::string>& paths,
+							std::vector<int>& errors);
+
+	// Where this backend puts a form's art, as handed to writeAll: the
+	// file executeAction would create, so inside the output root once
+	// ShrubberyCreationForm::setOutputRoot installed one
+	virtual std::string	pathFor(const ShrubberyCreationForm& form) const;
+
+	// tryExecute for each form, with the file at pathFor(form) written by
+	// this backend. A file that could not be written or made durable sets
+	// actionFailed and error, like an executeAction that threw. latencyNs
+	// is the time of the whole batch, durability included.
+	// Returns the number of files written.
+	size_t	execute(const ShrubberyCreationForm* const* forms, size_t count,
+				const Bureaucrat& executor, FormExecutor::Result* results);
+
+	// io_uring when the kernel allows it, the thread pool otherwise
+	static ShrubberyOutput*	create(int threads = 4);
+};
+
+// Workers claim paths one by one and do open/pwrite/close each. They are
+// started once and sleep between batches; the calling thread claims paths
+// too, so a pool whose threads failed to start still writes everything.
+class PoolShrubberyOutput : public ShrubberyOutput
+{
+private:
+	int								threads;
+	std::vector<pthread_t>			workers;	// the ones that started
+	pthread_mutex_t					lock;
+	pthread_cond_t					batchReady;
+	pthread_cond_t					batchDone;
+	const std::vector<std::string>*	batchPaths;
+	std::vector<int>*				batchErrors;
+	size_t							next;		// next path to claim
+	unsigned long					batch;		// batches handed out so far
+	size_t							finished;	// workers done with this batch
+	bool							stopping;
+
+	void			start();
+	void			stop();
+	void			claimPaths();
+	static void*	workerMain(void* arg);
+
+public:
+	PoolShrubberyOutput(int threads = 4);
+	PoolShrubberyOutput(const PoolShrubberyOutput& other);
+	PoolShrubberyOutput& operator=(const PoolShrubberyOutput& other);
+	~PoolShrubberyOutput();
+
+	void		writeAll(const std::vector<std::string>& paths, std::vector<int>& errors);
+	const char*	name() const;
+};
+
+// io_uring through raw syscalls (no liburing). Each file is a linked
+// openat -> write -> close chain on a fixed-file slot, so a whole window
+// of files costs one io_uring_enter instead of three syscalls each.
+// Needs Linux 5.17 or later (direct descriptors); tryCreate() returns
+// NULL when the kernel, the headers or a seccomp filter say no.
+class UringShrubberyOutput : public ShrubberyOutput
+{
+private:
+	int			ringFd;
+	void*		ring;		// SQ and CQ rings share one mapping
+	size_t		ringSize;
+	void*		sqes;
+	size_t		sqesSize;
+	unsigned*	sqTail;
+	unsigned	sqMask;
+	unsigned*	sqArray;
+	unsigned*	cqHead;
+	unsigned*	cqTail;
+	unsigned	cqMask;
+	void*		cqes;
+	unsigned	slots;		// files in flight per window
+
+	UringShrubberyOutput();
+	UringShrubberyOutput(const UringShrubberyOutput& other);
+	UringShrubberyOutput& operator=(const UringShrubberyOutput& other);
+
+	bool		setup(unsigned entries);
+	void		reap(std::vector<int>& errors, size_t base,
+					std::vector<unsigned char>& steps, size_t& reaped);
+
+public:
+	~UringShrubberyOutput();
+
+	static UringShrubberyOutput*	tryCreate(unsigned filesInFlight = 64);
+
+	void		writeAll(const std::vector<std::string>& paths, std::vector<int>& errors);
+	const char*	name() const;
+};
+
+#endif
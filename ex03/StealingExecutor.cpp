@@ -0,0 +1,247 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   StealingExecutor.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/19 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/19 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "StealingExecutor.hpp"
+
+StealingExecutor::StealingExecutor(int threads)
+	: started(0), nextWorker(0), queued(0), pending(0), stopping(false)
+{
+	if (threads < 1)
+		threads = 1;
+	pthread_mutex_init(&submitLock, NULL);
+	pthread_mutex_init(&idleLock, NULL);
+	pthread_cond_init(&workReady, NULL);
+	pthread_cond_init(&allDone, NULL);
+	for (int i = 0; i < threads; i++)
+	{
+		Worker* worker = new Worker();
+		worker->pool = this;
+		worker->index = i;
+		worker->busyNs = 0;
+		worker->steals = 0;
+		pthread_mutex_init(&worker->lock, NULL);
+		workers.push_back(worker);
+	}
+	// Started only once every deque exists, since workers steal from all.
+	// A deque whose thread did not start stays empty: submit skips it.
+	while (started < workers.size()
+		&& pthread_create(&workers[started]->thread, NULL, &StealingExecutor::workerMain,
+			workers[started]) == 0)
+		started++;
+}
+
+StealingExecutor::StealingExecutor(const StealingExecutor& other)
+	: started(0), nextWorker(0), queued(0), pending(0), stopping(false)
+{
+	(void)other;
+}
+
+StealingExecutor& StealingExecutor::operator=(const StealingExecutor& other)
+{
+	(void)other;
+	return *this;
+}
+
+StealingExecutor::~StealingExecutor()
+{
+	wait();
+	pthread_mutex_lock(&idleLock);
+	stopping = true;
+	pthread_cond_broadcast(&workReady);
+	pthread_mutex_unlock(&idleLock);
+	for (size_t i = 0; i < workers.size(); i++)
+	{
+		if (i < started)
+			pthread_join(workers[i]->thread, NULL);
+		pthread_mutex_destroy(&workers[i]->lock);
+		delete workers[i];
+	}
+	pthread_cond_destroy(&allDone);
+	pthread_cond_destroy(&workReady);
+	pthread_mutex_destroy(&idleLock);
+	pthread_mutex_destroy(&submitLock);
+}
+
+bool StealingExecutor::popLocal(Worker& worker, Job& job)
+{
+	bool found = false;
+
+	pthread_mutex_lock(&worker.lock);
+	if (!worker.jobs.empty())
+	{
+		job = worker.jobs.front();
+		worker.jobs.pop_front();
+		found = true;
+	}
+	pthread_mutex_unlock(&worker.lock);
+	if (found)
+		__atomic_sub_fetch(&queued, 1, __ATOMIC_ACQ_REL);
+	return found;
+}
+
+// Takes from the back, away from the end the owner is working on
+bool StealingExecutor::steal(Worker& thief, Job& job)
+{
+	size_t count = workers.size();
+
+	for (size_t n = 1; n < count; n++)
+	{
+		Worker& victim = *workers[(thief.index + n) % count];
+		bool found = false;
+
+		pthread_mutex_lock(&victim.lock);
+		if (!victim.jobs.empty())
+		{
+			job = victim.jobs.back();
+			victim.jobs.pop_back();
+			found = true;
+		}
+		pthread_mutex_unlock(&victim.lock);
+		if (found)
+		{
+			__atomic_sub_fetch(&queued, 1, __ATOMIC_ACQ_REL);
+			thief.steals++;
+			return true;
+		}
+	}
+	return false;
+}
+
+void StealingExecutor::finish(Worker& worker, const Job& job, double start)
+{
+	double end = FormExecutor::now();
+
+	job.result->latencyNs = end - job.submitted;
+	worker.busyNs += end - start;
+	if (__atomic_sub_fetch(&pending, 1, __ATOMIC_ACQ_REL) == 0)
+	{
+		pthread_mutex_lock(&idleLock);
+		pthread_cond_broadcast(&allDone);
+		pthread_mutex_unlock(&idleLock);
+	}
+}
+
+void* StealingExecutor::workerMain(void* self)
+{
+	Worker& worker = *static_cast<Worker*>(self);
+	StealingExecutor& pool = *worker.pool;
+	Job job;
+
+	for (;;)
+	{
+		if (pool.popLocal(worker, job) || pool.steal(worker, job))
+		{
+			double start = FormExecutor::now();
+			FormExecutor::run(*job.form, *job.executor, *job.result);
+			pool.finish(worker, job, start);
+			continue;
+		}
+		pthread_mutex_lock(&pool.idleLock);
+		while (__atomic_load_n(&pool.queued, __ATOMIC_ACQUIRE) == 0 && !pool.stopping)
+			pthread_cond_wait(&pool.workReady, &pool.idleLock);
+		bool done = pool.stopping && __atomic_load_n(&pool.queued, __ATOMIC_ACQUIRE) == 0;
+		pthread_mutex_unlock(&pool.idleLock);
+		if (done)
+			break;
+	}
+	return NULL;
+}
+
+size_t StealingExecutor::submit(const AForm& form, const Bureaucrat& executor)
+{
+	Job job;
+
+	pthread_mutex_lock(&submitLock);
+	size_t ticket = results.size();
+	results.push_back(Result());
+	if (started == 0)
+	{
+		// No worker thread: run the job here, charged to the first worker
+		Result& result = results.back();
+		double start = FormExecutor::now();
+		FormExecutor::run(form, executor, result);
+		double end = FormExecutor::now();
+		result.latencyNs = end - start;
+		workers[0]->busyNs += end - start;
+		pthread_mutex_unlock(&submitLock);
+		return ticket;
+	}
+	job.form = &form;
+	job.executor = &executor;
+	job.result = &results.back();
+	job.submitted = FormExecutor::now();
+	Worker& worker = *workers[nextWorker];
+	nextWorker = (nextWorker + 1) % started;
+	__atomic_add_fetch(&pending, 1, __ATOMIC_ACQ_REL);
+	pthread_mutex_unlock(&submitLock);
+
+	pthread_mutex_lock(&worker.lock);
+	worker.jobs.push_back(job);
+	pthread_mutex_unlock(&worker.lock);
+	__atomic_add_fetch(&queued, 1, __ATOMIC_ACQ_REL);
+
+	// Taking idleLock before signalling means a worker that just saw
+	// queued == 0 is already waiting and cannot miss the wake-up
+	pthread_mutex_lock(&idleLock);
+	pthread_cond_signal(&workReady);
+	pthread_mutex_unlock(&idleLock);
+	return ticket;
+}
+
+void StealingExecutor::wait()
+{
+	pthread_mutex_lock(&idleLock);
+	while (__atomic_load_n(&pending, __ATOMIC_ACQUIRE) > 0)
+		pthread_cond_wait(&allDone, &idleLock);
+	pthread_mutex_unlock(&idleLock);
+}
+
+const StealingExecutor::Result& StealingExecutor::result(size_t ticket) const
+{
+	return results[ticket];
+}
+
+size_t StealingExecutor::resultCount() const
+{
+	return results.size();
+}
+
+void StealingExecutor::clearResults()
+{
+	pthread_mutex_lock(&submitLock);
+	if (__atomic_load_n(&pending, __ATOMIC_ACQUIRE) == 0)
+		results.clear();
+	pthread_mutex_unlock(&submitLock);
+}
+
+int StealingExecutor::getThreadCount() const
+{
+	return static_cast<int>(started);
+}
+
+double StealingExecutor::getBusyTime() const
+{
+	double total = 0;
+
+	for (size_t i = 0; i < workers.size(); i++)
+		total += workers[i]->busyNs;
+	return total;
+}
+
+unsigned long StealingExecutor::getStealCount() const
+{
+	unsigned long total = 0;
+
+	for (size_t i = 0; i < workers.size(); i++)
+		total += workers[i]->steals;
+	return total;
+}
@@ -0,0 +1,89 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   StealingExecutor.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/19 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/19 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef STEALINGEXECUTOR_HPP
+#define STEALINGEXECUTOR_HPP
+
+#include <pthread.h>
+#include <deque>
+#include <vector>
+#include "FormExecutor.hpp"
+
+// Same contract as FormExecutor, but every worker owns a deque. Jobs are
+// dealt round-robin to the deques; a worker runs its own jobs oldest first
+// and, once its deque is empty, steals the newest job of another worker.
+// A worker stuck on a slow Shrubbery write therefore never holds back the
+// cheap jobs queued behind it.
+// If some threads cannot be started, jobs are dealt to the deques of the
+// ones that did; with none, submit() runs each job itself.
+class StealingExecutor
+{
+public:
+	typedef FormExecutor::Result	Result;
+
+private:
+	struct Job
+	{
+		const AForm*		form;
+		const Bureaucrat*	executor;
+		Result*				result;
+		double				submitted;
+	};
+
+	struct Worker
+	{
+		StealingExecutor*	pool;
+		size_t				index;
+		pthread_t			thread;
+		pthread_mutex_t		lock;		// guards jobs
+		std::deque<Job>		jobs;
+		double				busyNs;
+		unsigned long		steals;
+	};
+
+	std::vector<Worker*>	workers;
+	size_t					started;	// workers[0..started) have a thread
+	std::deque<Result>		results;	// indexed by ticket, never moves
+	size_t					nextWorker;
+	size_t					queued;		// jobs sitting in a deque (atomic)
+	size_t					pending;	// submitted but not finished (atomic)
+	bool					stopping;
+	pthread_mutex_t			submitLock;	// guards results and nextWorker
+	pthread_mutex_t			idleLock;
+	pthread_cond_t			workReady;
+	pthread_cond_t			allDone;
+
+	StealingExecutor(const StealingExecutor& other);
+	StealingExecutor& operator=(const StealingExecutor& other);
+
+	static void*	workerMain(void* self);
+	bool			popLocal(Worker& worker, Job& job);
+	bool			steal(Worker& thief, Job& job);
+	void			finish(Worker& worker, const Job& job, double start);
+
+public:
+	StealingExecutor(int threads);
+	~StealingExecutor();	// finishes the queued jobs, then joins the workers
+
+	size_t			submit(const AForm& form, const Bureaucrat& executor);
+	void			wait();
+	const Result&	result(size_t ticket) const;
+	size_t			resultCount() const;
+	void			clearResults();	// only while nothing is pending
+	int				getThreadCount() const;
+
+	// Read after wait()
+	double			getBusyTime() const;
+	unsigned long	getStealCount() const;
+};
+
+#endif
@@ -0,0 +1,35 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Trace.cpp                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/12 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/12 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Trace.hpp"
+#include <cstdlib>
+
+static int initialTraceLevel()
+{
+	const char* env = std::getenv("BUREAUCRAT_TRACE");
+
+	if (env == NULL || *env == '\0')
+		return TRACE_LIFECYCLE;
+	return std::atoi(env);
+}
+
+int g_traceLevel = initialTraceLevel();
+
+void setTraceLevel(int level)
+{
+	g_traceLevel = level;
+}
+
+int getTraceLevel()
+{
+	return g_traceLevel;
+}
@@ -0,0 +1,41 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Trace.hpp                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/12 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/12 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <iostream>
+
+// Lifecycle messages ("copy constructor called", "Destructor called for
+// ...") of AForm and Bureaucrat. The level can be changed at runtime with
+// setTraceLevel() or the BUREAUCRAT_TRACE environment variable; building
+// with TRACE=0 (-DNO_TRACE) removes the messages from the binary.
+enum TraceLevel
+{
+	TRACE_NONE = 0,
+	TRACE_COPIES = 1,		// copy constructors and assignments
+	TRACE_LIFECYCLE = 2		// also constructors and destructors (default)
+};
+
+extern int	g_traceLevel;
+
+void	setTraceLevel(int level);
+int		getTraceLevel();
+
+#ifdef NO_TRACE
+# define TRACE(level, message)	((void)0)
+#else
+# define TRACE(level, message) \
+	do { if (g_traceLevel >= (level)) std::cout << message << std::endl; } while (0)
+#endif
+
+#endif
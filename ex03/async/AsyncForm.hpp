@@ -0,0 +1,70 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   AsyncForm.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/20 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/20 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef ASYNCFORM_HPP
+#define ASYNCFORM_HPP
+
+#include "EventLoop.hpp"
+#include "../Bureaucrat.hpp"
+#include "../FormExecutor.hpp"
+
+// co_await executeFormAsync(loop, bureaucrat, form) behaves like
+// bureaucrat.executeForm(form): same checks, same outcome line in the
+// audit sink. The coroutine is suspended while the form runs on one of
+// the loop's blocking threads, and resumed on the loop thread afterwards.
+class ExecuteFormAwaiter
+{
+private:
+	EventLoop&				loop;
+	const Bureaucrat&		bureaucrat;
+	const AForm&			form;
+	FormExecutor::Result	result;
+
+public:
+	ExecuteFormAwaiter(EventLoop& loop, const Bureaucrat& bureaucrat, const AForm& form)
+		: loop(loop), bureaucrat(bureaucrat), form(form), result() {}
+
+	bool	await_ready() const noexcept { return false; }
+
+	void	await_suspend(std::coroutine_handle<> handle)
+	{
+		loop.suspendBegin();
+		loop.offload([this, handle] {
+			FormExecutor::run(form, bureaucrat, result);
+			loop.post(handle);
+		});
+	}
+
+	FormExecutor::Result	await_resume()
+	{
+		AuditSink& sink = Bureaucrat::getAuditSink();
+
+		loop.suspendEnd();
+		if (result.actionFailed)
+			sink.record(AUDIT_EXECUTE_FAILED, bureaucrat.getName(), form.getName(),
+				result.error.c_str());
+		else if (result.status != FORM_OK)
+			sink.record(AUDIT_EXECUTE_FAILED, bureaucrat.getName(), form.getName(),
+				AForm::resultMessage(result.status));
+		else
+			sink.record(AUDIT_EXECUTED, bureaucrat.getName(), form.getName(), nullptr);
+		return result;
+	}
+};
+
+inline ExecuteFormAwaiter executeFormAsync(EventLoop& loop, const Bureaucrat& bureaucrat,
+	const AForm& form)
+{
+	return ExecuteFormAwaiter(loop, bureaucrat, form);
+}
+
+#endif
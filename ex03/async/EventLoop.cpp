@@ -0,0 +1,118 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   EventLoop.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/20 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/20 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "EventLoop.hpp"
+#include <exception>
+
+void Task::promise_type::unhandled_exception()
+{
+	std::terminate();
+}
+
+EventLoop::EventLoop(int blockingThreads)
+{
+	if (blockingThreads < 1)
+		blockingThreads = 1;
+	for (int i = 0; i < blockingThreads; i++)
+		workers.emplace_back(&EventLoop::workerMain, this);
+}
+
+EventLoop::~EventLoop()
+{
+	{
+		std::lock_guard<std::mutex> guard(workLock);
+		stopping = true;
+	}
+	workReady.notify_all();
+	for (std::thread& worker : workers)
+		worker.join();
+}
+
+void EventLoop::workerMain()
+{
+	for (;;)
+	{
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> guard(workLock);
+			workReady.wait(guard, [this] { return stopping || !work.empty(); });
+			if (work.empty())
+				return;
+			job = std::move(work.front());
+			work.pop_front();
+		}
+		job();
+	}
+}
+
+void EventLoop::spawn(Task task)
+{
+	task.handle.promise().loop = this;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		live++;
+	}
+	post(task.handle);
+}
+
+void EventLoop::post(std::coroutine_handle<> handle)
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		ready.push_back(handle);
+	}
+	wakeUp.notify_one();
+}
+
+void EventLoop::offload(std::function<void()> job)
+{
+	{
+		std::lock_guard<std::mutex> guard(workLock);
+		work.push_back(std::move(job));
+	}
+	workReady.notify_one();
+}
+
+// Called from a task's final suspend, on the loop thread
+void EventLoop::taskFinished()
+{
+	std::lock_guard<std::mutex> guard(lock);
+	live--;
+}
+
+void EventLoop::suspendBegin()
+{
+	if (++suspended > peak)
+		peak = suspended;
+}
+
+void EventLoop::suspendEnd()
+{
+	suspended--;
+}
+
+void EventLoop::run()
+{
+	for (;;)
+	{
+		std::coroutine_handle<> handle;
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			wakeUp.wait(guard, [this] { return live == 0 || !ready.empty(); });
+			if (ready.empty())
+				return;
+			handle = ready.front();
+			ready.pop_front();
+		}
+		handle.resume();
+	}
+}
@@ -0,0 +1,116 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   EventLoop.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/20 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/20 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef EVENTLOOP_HPP
+#define EVENTLOOP_HPP
+
+// C++20 only: built by make bench-async, never by the C++98 targets
+
+#include <coroutine>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class EventLoop;
+
+// Coroutine started with EventLoop::spawn. It runs on the loop thread and
+// frees its own frame when it returns.
+class Task
+{
+public:
+	struct promise_type
+	{
+		EventLoop*	loop = nullptr;
+
+		Task				get_return_object();
+		std::suspend_always	initial_suspend() noexcept { return {}; }
+		auto				final_suspend() noexcept;
+		void				return_void() {}
+		void				unhandled_exception();
+	};
+
+	explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+private:
+	std::coroutine_handle<promise_type>	handle;
+
+	friend class EventLoop;
+};
+
+// One thread resumes coroutines; a few blocking-work threads run whatever
+// they offload (file writes, form actions) and post them back when done.
+// Thousands of suspended coroutines cost a frame each, not a thread each.
+class EventLoop
+{
+private:
+	std::mutex								lock;
+	std::condition_variable					wakeUp;
+	std::deque<std::coroutine_handle<>>		ready;
+	size_t									live = 0;	// spawned, not finished
+	size_t									suspended = 0;	// parked on offloaded work
+	size_t									peak = 0;
+
+	std::mutex								workLock;
+	std::condition_variable					workReady;
+	std::deque<std::function<void()>>		work;
+	bool									stopping = false;
+	std::vector<std::thread>				workers;
+
+	void	workerMain();
+
+public:
+	explicit EventLoop(int blockingThreads);
+	~EventLoop();
+	EventLoop(const EventLoop&) = delete;
+	EventLoop& operator=(const EventLoop&) = delete;
+
+	void	spawn(Task task);
+	void	run();	// returns once every spawned task has finished
+
+	void	post(std::coroutine_handle<> handle);		// any thread
+	void	offload(std::function<void()> job);		// runs on a worker
+	void	taskFinished();
+
+	// Loop thread only: an awaiter calls these around its offloaded work
+	void	suspendBegin();
+	void	suspendEnd();
+
+	// Most coroutines suspended on offloaded work at the same time
+	size_t	peakInFlight() const { return peak; }
+};
+
+inline Task Task::promise_type::get_return_object()
+{
+	return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+}
+
+inline auto Task::promise_type::final_suspend() noexcept
+{
+	struct Finish
+	{
+		bool	await_ready() const noexcept { return false; }
+		void	await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+		{
+			EventLoop* loop = handle.promise().loop;
+			handle.destroy();
+			loop->taskFinished();
+		}
+		void	await_resume() const noexcept {}
+	};
+	return Finish();
+}
+
+#endif
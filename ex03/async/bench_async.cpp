@@ -0,0 +1,128 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_async.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/20 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/20 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "AsyncForm.hpp"
+#include "../bench/Bench.hpp"
+#include "../ShrubberyCreationForm.hpp"
+#include "../Trace.hpp"
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+	const char* const	dir = "/tmp/bench_async";
+
+	class DiscardAuditSink : public AuditSink
+	{
+	public:
+		void record(AuditEvent, const std::string&, const std::string&, const char*) {}
+	};
+
+	Task executeOne(EventLoop& loop, const Bureaucrat& boss, const AForm& form)
+	{
+		co_await executeFormAsync(loop, boss, form);
+	}
+
+	// Every form in flight at once, parked as a coroutine frame
+	void runCoroutines(const std::vector<std::unique_ptr<AForm>>& forms,
+		const Bureaucrat& boss, int blockingThreads)
+	{
+		EventLoop loop(blockingThreads);
+		double start = benchNow();
+
+		for (const std::unique_ptr<AForm>& form : forms)
+			loop.spawn(executeOne(loop, boss, *form));
+		loop.run();
+		double elapsed = benchNow() - start;
+
+		benchReport("coroutines, " + std::to_string(blockingThreads) + " blocking threads",
+			elapsed, static_cast<long>(forms.size()));
+		std::printf("    peak suspended on execution: %zu\n", loop.peakInFlight());
+	}
+
+	// Every form in flight at once, each holding its own thread
+	void runThreadPerJob(const std::vector<std::unique_ptr<AForm>>& forms,
+		const Bureaucrat& boss)
+	{
+		std::vector<std::thread> threads;
+		std::atomic<size_t> running(0);
+		std::atomic<size_t> peak(0);
+		size_t failed = 0;
+		double start = benchNow();
+
+		threads.reserve(forms.size());
+		for (const std::unique_ptr<AForm>& form : forms)
+		{
+			try
+			{
+				threads.emplace_back([&running, &peak, &boss, &form] {
+					size_t now = ++running;
+					size_t seen = peak.load();
+					while (now > seen && !peak.compare_exchange_weak(seen, now))
+						;
+					FormExecutor::Result result;
+					FormExecutor::run(*form, boss, result);
+					running--;
+				});
+			}
+			catch (const std::system_error&)
+			{
+				failed++;
+			}
+		}
+		for (std::thread& thread : threads)
+			thread.join();
+		double elapsed = benchNow() - start;
+
+		benchReport("thread per job", elapsed, static_cast<long>(forms.size() - failed));
+		std::printf("    threads started: %zu, failed to start: %zu, peak running: %zu\n",
+			threads.size(), failed, peak.load());
+	}
+}
+
+int main()
+{
+	const size_t counts[] = { 1000, 10000 };
+	DiscardAuditSink discard;
+
+	setTraceLevel(TRACE_NONE);
+	Bureaucrat::setAuditSink(&discard);
+	mkdir(dir, 0755);
+	{
+		Bureaucrat boss("Boss", 1);
+		for (size_t count : counts)
+		{
+			std::vector<std::unique_ptr<AForm>> forms;
+			for (size_t i = 0; i < count; i++)
+			{
+				forms.emplace_back(new ShrubberyCreationForm(std::string(dir) + "/t" + std::to_string(i)));
+				forms.back()->trySign(boss);
+				forms.back()->tryExecute(boss);	// create the file up front
+			}
+
+			benchHeader("Shrubbery executions in flight: " + std::to_string(count));
+			runCoroutines(forms, boss, 4);
+			runThreadPerJob(forms, boss);
+
+			for (const std::unique_ptr<AForm>& form : forms)
+				std::remove((form->getTarget() + "_shrubbery").c_str());
+		}
+	}
+	rmdir(dir);
+	Bureaucrat::setAuditSink(nullptr);
+	return 0;
+}
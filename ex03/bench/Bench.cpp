@@ -0,0 +1,156 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Bench.cpp                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/10 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/20 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <new>
+#include <time.h>
+
+static const void* volatile g_sink;
+
+// Results always reach the real stdout, even inside a BenchQuiet scope
+static std::ostream g_report(std::cout.rdbuf());
+static unsigned long g_allocations = 0;
+static bool g_failed = false;
+
+// Every allocation of the benchmark binary goes through here, so the
+// harness can report allocations per operation without any library
+void* operator new(size_t size) throw(std::bad_alloc)
+{
+	__atomic_add_fetch(&g_allocations, 1, __ATOMIC_RELAXED);
+	void* p = std::malloc(size ? size : 1);
+	if (p == NULL)
+		throw std::bad_alloc();
+	return p;
+}
+
+void* operator new[](size_t size) throw(std::bad_alloc)
+{
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) throw()
+{
+	__atomic_add_fetch(&g_allocations, 1, __ATOMIC_RELAXED);
+	return std::malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) throw()
+{
+	return operator new(size, tag);
+}
+
+void operator delete(void* p) throw()
+{
+	std::free(p);
+}
+
+void operator delete[](void* p) throw()
+{
+	std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) throw()
+{
+	std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) throw()
+{
+	std::free(p);
+}
+
+unsigned long benchAllocations()
+{
+	return __atomic_load_n(&g_allocations, __ATOMIC_RELAXED);
+}
+
+double benchNow()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+void benchSink(const void* p)
+{
+	g_sink = p;
+}
+
+void benchFail(const std::string& what)
+{
+	g_failed = true;
+	g_report << "  FAILED: " << what << std::endl;
+}
+
+bool benchFailed()
+{
+	return g_failed;
+}
+
+void benchHeader(const std::string& title)
+{
+	g_report << "\n== " << title << " ==" << std::endl;
+}
+
+static void printLine(const std::string& label, double elapsedNs, long ops)
+{
+	double nsPerOp = ops ? elapsedNs / ops : 0.0;
+	double opsPerSec = elapsedNs > 0 ? ops * 1e9 / elapsedNs : 0.0;
+
+	g_report << "  " << std::left << std::setw(40) << label << std::right
+	          << std::fixed << std::setprecision(1)
+	          << std::setw(12) << nsPerOp << " ns/op"
+	          << std::setprecision(0)
+	          << std::setw(16) << opsPerSec << " ops/s";
+}
+
+void benchReport(const std::string& label, double elapsedNs, long ops)
+{
+	printLine(label, elapsedNs, ops);
+	g_report << std::endl;
+}
+
+void benchReport(const std::string& label, double elapsedNs, long ops,
+	unsigned long allocations)
+{
+	printLine(label, elapsedNs, ops);
+	g_report << std::setprecision(2)
+	          << std::setw(10) << (ops ? static_cast<double>(allocations) / ops : 0.0)
+	          << " allocs/op" << std::endl;
+}
+
+void benchRun(const std::string& label, BenchBody body, void* ctx,
+	long iterations, int repetitions)
+{
+	double best = 0;
+	unsigned long bestAllocations = 0;
+
+	body(ctx, iterations / 10 + 1);
+	for (int r = 0; r < repetitions; r++)
+	{
+		unsigned long allocations = benchAllocations();
+		double start = benchNow();
+		body(ctx, iterations);
+		double elapsed = benchNow() - start;
+		allocations = benchAllocations() - allocations;
+		if (r == 0 || elapsed < best)
+		{
+			best = elapsed;
+			bestAllocations = allocations;
+		}
+	}
+	benchReport(label, best, iterations, bestAllocations);
+}
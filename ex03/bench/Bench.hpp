@@ -0,0 +1,100 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Bench.hpp                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/10 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/10 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <string>
+#include <iostream>
+#include <streambuf>
+
+// Monotonic clock in nanoseconds
+double	benchNow();
+
+// Prints one result line: label, ns/op, ops/sec and, when known,
+// heap allocations per operation
+void	benchReport(const std::string& label, double elapsedNs, long ops);
+void	benchReport(const std::string& label, double elapsedNs, long ops,
+			unsigned long allocations);
+
+// Number of operator new calls made so far by the whole process
+unsigned long	benchAllocations();
+
+// Body of a repeated benchmark: performs `iterations` operations on ctx
+typedef void	(*BenchBody)(void* ctx, long iterations);
+
+// Runs body once to warm caches and branch predictors, then `repetitions`
+// times, and reports the fastest repetition with its allocation count
+void	benchRun(const std::string& label, BenchBody body, void* ctx,
+			long iterations, int repetitions = 5);
+
+// Section title for a group of results
+void	benchHeader(const std::string& title);
+
+// Keeps the optimizer from dropping a computed value
+void	benchSink(const void* p);
+
+// Prints "FAILED: what" and makes the bench binary exit with status 1
+// once every selected group has run
+void	benchFail(const std::string& what);
+bool	benchFailed();
+
+// Silences std::cout and std::cerr for its lifetime, so the demo
+// messages printed by the forms do not end up in the measurements
+class BenchQuiet
+{
+private:
+	class NullBuffer : public std::streambuf
+	{
+		protected:
+			int	overflow(int c) { return c; }
+	};
+
+	NullBuffer		null;
+	std::streambuf*	savedOut;
+	std::streambuf*	savedErr;
+
+	BenchQuiet(const BenchQuiet& other);
+	BenchQuiet& operator=(const BenchQuiet& other);
+
+public:
+	BenchQuiet() : savedOut(std::cout.rdbuf(&null)), savedErr(std::cerr.rdbuf(&null)) {}
+	~BenchQuiet() { std::cout.rdbuf(savedOut); std::cerr.rdbuf(savedErr); }
+};
+
+// One entry point per benchmark file
+void	benchCore();
+void	benchRegistry();
+void	benchArena();
+void	benchBatch();
+void	benchTrace();
+void	benchAudit();
+void	benchRejection();
+void	benchExecutor();
+void	benchSigning();
+void	benchStealing();
+void	benchTable();
+void	benchIndex();
+void	benchRoster();
+void	benchPipeline();
+void	benchRandom();
+void	benchRobotomyBatch();
+void	benchShrubbery();
+void	benchOutput();
+void	benchArchive();
+void	benchDedup();
+void	benchDurability();
+void	benchRoot();
+void	benchCodec();
+void	benchFormat();
+
+#endif
@@ -0,0 +1,184 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_archive.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/28 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/28 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../ShrubberyArchive.hpp"
+#include "../Trace.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <unistd.h>
+#include <sys/stat.h>
+
+static const char* g_archive = "/tmp/bench_archive.shrb";
+static const char* g_dir = "/tmp/bench_archive";
+
+static std::string nameOf(size_t i)
+{
+	std::ostringstream name;
+
+	name << "t" << i << "_shrubbery";
+	return name.str();
+}
+
+// Every name present with the art, except the ones rewritten as "moved"
+static size_t verify(size_t count, size_t moved)
+{
+	ShrubberyArchiveReader reader;
+	size_t mismatches = 0;
+	const char* data;
+	size_t size;
+
+	if (!reader.open(g_archive))
+		return count;
+	for (size_t i = 0; i < count; i++)
+	{
+		if (!reader.find(nameOf(i), data, size))
+			mismatches++;
+		else if (i < moved)
+			mismatches += size != 5 || std::memcmp(data, "moved", 5) != 0;
+		else
+			mismatches += size != ShrubberyCreationForm::getArtSize()
+				|| std::memcmp(data, ShrubberyCreationForm::getArt(), size) != 0;
+	}
+	mismatches += reader.size() != count;
+	mismatches += reader.find("nobody_shrubbery", data, size);
+	return mismatches;
+}
+
+// A file that is not an archive is refused and left as it was
+static void checkForeignFile()
+{
+	const char* text = "not an archive\n";
+	FILE* file = std::fopen(g_dir, "w");
+	bool refused;
+	struct stat info;
+
+	std::fputs(text, file);
+	std::fclose(file);
+	{
+		ShrubberyArchive archive;
+		refused = !archive.open(g_dir) && errno == EINVAL;
+	}
+	stat(g_dir, &info);
+	std::cout << "  foreign file refused with EINVAL and kept intact: "
+			  << (refused && info.st_size == static_cast<off_t>(std::strlen(text)) ? "yes" : "NO")
+			  << std::endl;
+	std::remove(g_dir);
+}
+
+static void run(size_t count)
+{
+	Bureaucrat boss("Boss", 1);
+	std::vector<ShrubberyCreationForm*> forms(count);
+	std::vector<FormExecutor::Result> results(count);
+	std::vector<std::string> names(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		names[i] = nameOf(i);
+		forms[i] = new ShrubberyCreationForm(names[i].substr(0, names[i].size() - 10));
+		forms[i]->trySign(boss);
+	}
+
+	// Archive: one file however many targets
+	std::remove(g_archive);
+	double start = benchNow();
+	{
+		ShrubberyArchive archive;
+		archive.open(g_archive);
+		archive.execute(&forms[0], count, boss, &results[0]);
+		archive.close();
+	}
+	benchReport("archive, execute + close", benchNow() - start, count);
+	std::cout << "  mismatches after writing: " << verify(count, 0) << std::endl;
+
+	// Reopen: append more, rewrite a few, then tear the index off
+	{
+		ShrubberyArchive archive;
+		archive.open(g_archive);
+		for (size_t i = 0; i < 10; i++)
+			archive.append(nameOf(i), "moved", 5);
+		for (size_t i = count; i < count + 1000; i++)
+			archive.append(nameOf(i), ShrubberyCreationForm::getArt(),
+				ShrubberyCreationForm::getArtSize());
+		archive.close();
+	}
+	std::cout << "  mismatches after reopening and appending: "
+			  << verify(count + 1000, 10) << std::endl;
+	struct stat info;
+	stat(g_archive, &info);
+	truncate(g_archive, info.st_size - 100);
+	{
+		ShrubberyArchive archive;
+		archive.open(g_archive);
+		archive.close();
+	}
+	std::cout << "  mismatches after recovering a torn index: "
+			  << verify(count + 1000, 10) << std::endl;
+	checkForeignFile();
+
+	ShrubberyArchiveReader reader;
+	const char* data;
+	size_t size;
+	size_t total = 0;
+	reader.open(g_archive);
+	start = benchNow();
+	for (size_t i = 0; i < count; i++)
+	{
+		size_t n = (i * 7919) % count;
+		if (reader.find(names[n], data, size))
+			total += size;
+	}
+	benchReport("reader, find by name", benchNow() - start, count);
+	benchSink(&total);
+	reader.close();
+
+	// The same targets as one file each
+	mkdir(g_dir, 0755);
+	std::vector<ShrubberyCreationForm*> fileForms(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		fileForms[i] = new ShrubberyCreationForm(std::string(g_dir) + "/" + names[i].substr(0,
+			names[i].size() - 10));
+		fileForms[i]->trySign(boss);
+	}
+	start = benchNow();
+	for (size_t i = 0; i < count; i++)
+		fileForms[i]->tryExecute(boss);
+	benchReport("one file per target", benchNow() - start, count);
+	start = benchNow();
+	for (size_t i = 0; i < count; i++)
+		std::remove((fileForms[i]->getTarget() + "_shrubbery").c_str());
+	benchReport("removing them again", benchNow() - start, count);
+	rmdir(g_dir);
+	std::remove(g_archive);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		delete forms[i];
+		delete fileForms[i];
+	}
+}
+
+void benchArchive()
+{
+	int savedTrace = getTraceLevel();
+
+	setTraceLevel(TRACE_NONE);
+	benchHeader("Shrubbery archive (100000 targets, ext4)");
+	run(100000);
+	setTraceLevel(savedTrace);
+}
@@ -0,0 +1,74 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_arena.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/10 14:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/10 14:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../Intern.hpp"
+#include "../Trace.hpp"
+#include <vector>
+
+static const char* const g_names[3] = {
+	"shrubbery creation",
+	"robotomy request",
+	"presidential pardon"
+};
+
+void benchArena()
+{
+	int savedTrace = getTraceLevel();
+	setTraceLevel(TRACE_NONE);
+
+	const size_t batch = 10000;
+	const int rounds = 50;
+	const long ops = static_cast<long>(batch) * rounds;
+
+	Intern intern;
+	std::string names[3] = { g_names[0], g_names[1], g_names[2] };
+	std::string target("target");
+
+	benchHeader("Form allocation (create + destroy, batches of 10000)");
+
+	std::vector<AForm*> forms(batch);
+	double elapsed;
+	unsigned long allocations;
+	{
+		BenchQuiet quiet;
+		allocations = benchAllocations();
+		double start = benchNow();
+		for (int r = 0; r < rounds; r++)
+		{
+			for (size_t i = 0; i < batch; i++)
+				forms[i] = intern.makeForm(names[i % 3], target);
+			for (size_t i = 0; i < batch; i++)
+				delete forms[i];
+		}
+		elapsed = benchNow() - start;
+		allocations = benchAllocations() - allocations;
+	}
+	benchReport("makeForm + delete", elapsed, ops, allocations);
+
+	FormArena arena(batch);
+	{
+		BenchQuiet quiet;
+		allocations = benchAllocations();
+		double start = benchNow();
+		for (int r = 0; r < rounds; r++)
+		{
+			for (size_t i = 0; i < batch; i++)
+				intern.makeForm(names[i % 3], target, arena);
+			arena.clear();
+		}
+		elapsed = benchNow() - start;
+		allocations = benchAllocations() - allocations;
+	}
+	benchReport("makeForm(arena) + clear", elapsed, ops, allocations);
+	setTraceLevel(savedTrace);
+}
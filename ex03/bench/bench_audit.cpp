@@ -0,0 +1,81 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_audit.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/13 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/13 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../Bureaucrat.hpp"
+#include "../PresidentialPardonForm.hpp"
+#include "../AsyncAuditSink.hpp"
+#include "../Trace.hpp"
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static const long g_perThread = 200000;
+
+// Successful signatures only, so exception unwinding stays out of the numbers
+static void* signLoop(void* arg)
+{
+	(void)arg;
+	Bureaucrat signer("Signer", 1);
+	PresidentialPardonForm form("Arthur Dent");
+
+	for (long i = 0; i < g_perThread; i++)
+		signer.signForm(form);
+	return NULL;
+}
+
+static double run(int threads)
+{
+	std::vector<pthread_t> ids(threads);
+	double start = benchNow();
+
+	for (int t = 0; t < threads; t++)
+		pthread_create(&ids[t], NULL, &signLoop, NULL);
+	for (int t = 0; t < threads; t++)
+		pthread_join(ids[t], NULL);
+	Bureaucrat::getAuditSink().flush();
+	return benchNow() - start;
+}
+
+void benchAudit()
+{
+	int savedTrace = getTraceLevel();
+	setTraceLevel(TRACE_NONE);
+
+	benchHeader("signForm outcome reporting (to /dev/null)");
+
+	// The console sink shares one std::ostream, so it only runs on one thread
+	{
+		std::ofstream devnull("/dev/null");
+		ConsoleAuditSink console(devnull);
+		Bureaucrat::setAuditSink(&console);
+		benchReport("ConsoleAuditSink, 1 thread", run(1), g_perThread);
+	}
+
+	int fd = open("/dev/null", O_WRONLY);
+	for (int threads = 1; threads <= 4; threads *= 2)
+	{
+		AsyncAuditSink async(fd);
+		Bureaucrat::setAuditSink(&async);
+		std::ostringstream label;
+		label << "AsyncAuditSink, " << threads << " thread(s)";
+		benchReport(label.str(), run(threads), g_perThread * threads);
+		Bureaucrat::setAuditSink(NULL);
+	}
+	close(fd);
+
+	Bureaucrat::setAuditSink(NULL);
+	setTraceLevel(savedTrace);
+}
@@ -0,0 +1,76 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_batch.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/11 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/11 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../Intern.hpp"
+#include "../Trace.hpp"
+#include <vector>
+#include <sstream>
+
+void benchBatch()
+{
+	int savedTrace = getTraceLevel();
+	setTraceLevel(TRACE_NONE);
+
+	const size_t batchSize = 10000;
+	const int rounds = 50;
+	const long ops = static_cast<long>(batchSize) * rounds;
+	const char* names[3] = {
+		"shrubbery creation",
+		"robotomy request",
+		"presidential pardon"
+	};
+
+	Intern intern;
+	std::vector<FormRequest> requests(batchSize);
+	for (size_t i = 0; i < batchSize; i++)
+	{
+		std::ostringstream target;
+		target << "target" << i;
+		requests[i].formName = names[i % 3];
+		requests[i].target = target.str();
+	}
+
+	benchHeader("Batch creation (10000 requests per batch)");
+
+	FormArena arena(batchSize);
+	double elapsed;
+	unsigned long allocations;
+	{
+		BenchQuiet quiet;
+		allocations = benchAllocations();
+		double start = benchNow();
+		for (int r = 0; r < rounds; r++)
+		{
+			for (size_t i = 0; i < batchSize; i++)
+				intern.makeForm(requests[i].formName, requests[i].target, arena);
+			arena.clear();
+		}
+		elapsed = benchNow() - start;
+		allocations = benchAllocations() - allocations;
+	}
+	benchReport("makeForm(arena) loop", elapsed, ops, allocations);
+
+	FormBatch batch;
+	{
+		BenchQuiet quiet;
+		allocations = benchAllocations();
+		double start = benchNow();
+		for (int r = 0; r < rounds; r++)
+			intern.makeForms(requests, batch);
+		batch.clear();
+		elapsed = benchNow() - start;
+		allocations = benchAllocations() - allocations;
+	}
+	benchReport("makeForms", elapsed, ops, allocations);
+	setTraceLevel(savedTrace);
+}
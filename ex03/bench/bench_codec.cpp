@@ -0,0 +1,180 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_codec.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/12/02 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/12/02 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../FormCodec.hpp"
+#include "../ShrubberyCreationForm.hpp"
+#include "../RobotomyRequestForm.hpp"
+#include "../PresidentialPardonForm.hpp"
+#include "../Trace.hpp"
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+// A million forms over a thousand targets, a third of each type, every
+// other one signed
+static void makeForms(size_t count, std::vector<AForm*>& forms)
+{
+	Bureaucrat boss("Boss", 1);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		std::ostringstream target;
+		target << "target" << i % 1000;
+		if (i % 3 == 0)
+			forms.push_back(new ShrubberyCreationForm(target.str()));
+		else if (i % 3 == 1)
+			forms.push_back(new RobotomyRequestForm(target.str()));
+		else
+			forms.push_back(new PresidentialPardonForm(target.str()));
+		if (i % 2 == 0)
+			forms.back()->trySign(boss);
+	}
+}
+
+static bool sameForm(const AForm& a, const AForm& b)
+{
+	return a.getName() == b.getName() && a.getTarget() == b.getTarget()
+		&& a.getGradeTosign() == b.getGradeTosign()
+		&& a.getGradeToExecute() == b.getGradeToExecute()
+		&& a.isFormSigned() == b.isFormSigned();
+}
+
+static void deleteAll(std::vector<AForm*>& forms)
+{
+	for (size_t i = 0; i < forms.size(); i++)
+		delete forms[i];
+	forms.clear();
+}
+
+// What a text snapshot can get back from an operator<< line
+static void parseLine(const std::string& line, std::string& name, int& sign, int& execute,
+	bool& isSigned)
+{
+	size_t comma = line.find(',');
+	std::istringstream in(line.substr(comma));
+	std::string word;
+
+	name = line.substr(6, comma - 6);	// after "Form: "
+	in >> word >> word >> word >> word >> sign >> word >> word >> word >> word >> execute
+	   >> word >> word >> word;
+	isSigned = word == "yes";
+}
+
+static void checkBureaucrats()
+{
+	FormCodec codec;
+	std::vector<Bureaucrat*> people;
+	std::vector<Bureaucrat*> decoded;
+	std::vector<unsigned char> records;
+	std::vector<unsigned char> table;
+	size_t wrong = 0;
+
+	for (int grade = 1; grade <= 150; grade++)
+	{
+		std::ostringstream name;
+		name << "clerk" << grade % 7;
+		people.push_back(new Bureaucrat(name.str(), grade));
+	}
+	codec.encodeBureaucrats(&people[0], people.size(), records);
+	codec.saveStrings(table);
+	FormCodec reader;
+	bool loaded = reader.loadStrings(&table[0], table.size())
+		&& reader.decodeBureaucrats(&records[0], people.size(), decoded);
+	for (size_t i = 0; i < decoded.size(); i++)
+		wrong += decoded[i]->getName() != people[i]->getName()
+			|| decoded[i]->getGrade() != people[i]->getGrade();
+	std::cout << "  150 bureaucrats: " << records.size() + table.size() << " bytes, "
+			  << (loaded && decoded.size() == people.size() && wrong == 0 ? "round trip exact" : "WRONG")
+			  << std::endl;
+	for (size_t i = 0; i < people.size(); i++)
+		delete people[i];
+	for (size_t i = 0; i < decoded.size(); i++)
+		delete decoded[i];
+}
+
+void benchCodec()
+{
+	const size_t count = 1000000;
+	int savedTrace = getTraceLevel();
+
+	setTraceLevel(TRACE_NONE);
+	benchHeader("Form snapshots (1000000 forms, 1000 targets)");
+	std::vector<AForm*> forms;
+	makeForms(count, forms);
+
+	// Text: operator<< one line per form, the only way out until now
+	double start = benchNow();
+	std::ostringstream text;
+	for (size_t i = 0; i < count; i++)
+		text << *forms[i] << '\n';
+	std::string snapshot = text.str();
+	benchReport("  text encode (operator<<)", benchNow() - start, count);
+
+	start = benchNow();
+	std::istringstream lines(snapshot);
+	std::string line;
+	std::string name;
+	int sign = 0;
+	int execute = 0;
+	bool isSigned = false;
+	size_t parsed = 0;
+	while (std::getline(lines, line))
+	{
+		parseLine(line, name, sign, execute, isSigned);
+		parsed += sign + execute + isSigned;
+	}
+	benchReport("  text parse (no target in it)", benchNow() - start, count);
+	benchSink(&parsed);
+
+	// Binary: records plus the string table
+	FormCodec codec;
+	std::vector<unsigned char> records;
+	std::vector<unsigned char> table;
+	records.reserve(count * FormCodec::RECORD_SIZE);
+	start = benchNow();
+	codec.encodeForms(&forms[0], count, records);
+	codec.saveStrings(table);
+	benchReport("  binary encode", benchNow() - start, count);
+
+	FormCodec reader;
+	std::vector<AForm*> decoded;
+	decoded.reserve(count);
+	start = benchNow();
+	bool fine = reader.loadStrings(&table[0], table.size())
+		&& reader.decodeForms(&records[0], count, decoded);
+	benchReport("  binary decode (new forms)", benchNow() - start, count);
+
+	size_t wrong = decoded.size() == count ? 0 : count;
+	for (size_t i = 0; i < decoded.size() && i < count; i++)
+		wrong += !sameForm(*forms[i], *decoded[i]);
+	std::cout << "  text " << snapshot.size() << " bytes ("
+			  << static_cast<double>(snapshot.size()) / count << " per form, targets not included)"
+			  << std::endl
+			  << "  binary " << records.size() + table.size() << " bytes ("
+			  << static_cast<double>(records.size() + table.size()) / count
+			  << " per form, targets included)" << std::endl
+			  << "  round trip: " << (fine ? "" : "decode FAILED, ") << wrong
+			  << " forms differ" << std::endl;
+
+	// A bad record is refused, not turned into a form
+	std::vector<unsigned char> bad(records.begin(), records.begin() + FormCodec::RECORD_SIZE);
+	bad[1] = 1;
+	std::vector<AForm*> none;
+	std::cout << "  record with foreign grades: "
+			  << (reader.decodeForms(&bad[0], 1, none) ? "ACCEPTED" : "rejected") << std::endl;
+	checkBureaucrats();
+
+	deleteAll(decoded);
+	deleteAll(forms);
+	setTraceLevel(savedTrace);
+}
@@ -0,0 +1,137 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_core.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/15 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/15 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../Intern.hpp"
+#include "../Bureaucrat.hpp"
+#include "../Trace.hpp"
+#include <cstdio>
+
+// The forms keep executeAction protected; these expose it to the bench
+class BenchShrubbery : public ShrubberyCreationForm
+{
+public:
+	BenchShrubbery(const std::string& target) : ShrubberyCreationForm(target) {}
+	void run() const { executeAction(); }
+};
+
+class BenchRobotomy : public RobotomyRequestForm
+{
+public:
+	BenchRobotomy(const std::string& target) : RobotomyRequestForm(target) {}
+	void run() const { executeAction(); }
+};
+
+class BenchPardon : public PresidentialPardonForm
+{
+public:
+	BenchPardon(const std::string& target) : PresidentialPardonForm(target) {}
+	void run() const { executeAction(); }
+};
+
+struct CoreContext
+{
+	Intern			intern;
+	std::string		names[3];
+	std::string		target;
+	Bureaucrat*		boss;
+	AForm*			pardon;
+	BenchShrubbery*	shrubbery;
+	BenchRobotomy*	robotomy;
+	BenchPardon*	pardonAction;
+};
+
+static void makeFormBody(void* ctx, long iterations)
+{
+	CoreContext& c = *static_cast<CoreContext*>(ctx);
+
+	for (long i = 0; i < iterations; i++)
+		delete c.intern.makeForm(c.names[i % 3], c.target);
+}
+
+static void signFormBody(void* ctx, long iterations)
+{
+	CoreContext& c = *static_cast<CoreContext*>(ctx);
+
+	for (long i = 0; i < iterations; i++)
+		c.boss->signForm(*c.pardon);
+}
+
+static void executeFormBody(void* ctx, long iterations)
+{
+	CoreContext& c = *static_cast<CoreContext*>(ctx);
+
+	for (long i = 0; i < iterations; i++)
+		c.boss->executeForm(*c.pardon);
+}
+
+static void shrubberyBody(void* ctx, long iterations)
+{
+	CoreContext& c = *static_cast<CoreContext*>(ctx);
+
+	for (long i = 0; i < iterations; i++)
+		c.shrubbery->run();
+}
+
+static void robotomyBody(void* ctx, long iterations)
+{
+	CoreContext& c = *static_cast<CoreContext*>(ctx);
+
+	for (long i = 0; i < iterations; i++)
+		c.robotomy->run();
+}
+
+static void pardonBody(void* ctx, long iterations)
+{
+	CoreContext& c = *static_cast<CoreContext*>(ctx);
+
+	for (long i = 0; i < iterations; i++)
+		c.pardonAction->run();
+}
+
+// Console output is discarded, not removed: the numbers include formatting
+void benchCore()
+{
+	int savedTrace = getTraceLevel();
+	CoreContext c;
+
+	setTraceLevel(TRACE_NONE);
+	c.names[0] = "shrubbery creation";
+	c.names[1] = "robotomy request";
+	c.names[2] = "presidential pardon";
+	c.target = "/tmp/bench_bureaucrat";
+	c.boss = new Bureaucrat("Boss", 1);
+	c.pardon = new PresidentialPardonForm("Arthur Dent");
+	c.shrubbery = new BenchShrubbery(c.target);
+	c.robotomy = new BenchRobotomy("Bender");
+	c.pardonAction = new BenchPardon("Ford Prefect");
+	c.pardon->trySign(*c.boss);
+
+	benchHeader("Core operations (best of 5, after warm-up)");
+	{
+		BenchQuiet quiet;
+		benchRun("Intern::makeForm + delete", &makeFormBody, &c, 200000);
+		benchRun("Bureaucrat::signForm", &signFormBody, &c, 500000);
+		benchRun("Bureaucrat::executeForm (pardon)", &executeFormBody, &c, 500000);
+		benchRun("Shrubbery executeAction", &shrubberyBody, &c, 5000);
+		benchRun("Robotomy executeAction", &robotomyBody, &c, 200000);
+		benchRun("Pardon executeAction", &pardonBody, &c, 500000);
+	}
+
+	std::remove("/tmp/bench_bureaucrat_shrubbery");
+	delete c.pardonAction;
+	delete c.robotomy;
+	delete c.shrubbery;
+	delete c.pardon;
+	delete c.boss;
+	setTraceLevel(savedTrace);
+}
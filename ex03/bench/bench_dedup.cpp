@@ -0,0 +1,158 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_dedup.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/29 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/29 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../DedupShrubberyOutput.hpp"
+#include "../Trace.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <vector>
+#include <unistd.h>
+#include <sys/stat.h>
+
+static void removeAll(const std::vector<ShrubberyCreationForm*>& forms)
+{
+	for (size_t i = 0; i < forms.size(); i++)
+		std::remove((forms[i]->getTarget() + "_shrubbery").c_str());
+}
+
+// Allocated bytes, counting a hard-linked inode once (what du reports)
+static unsigned long long diskUsage(const std::vector<ShrubberyCreationForm*>& forms)
+{
+	std::set<ino_t> seen;
+	unsigned long long bytes = 0;
+	struct stat st;
+
+	for (size_t i = 0; i < forms.size(); i++)
+	{
+		if (stat((forms[i]->getTarget() + "_shrubbery").c_str(), &st) != 0)
+			continue;
+		if (seen.insert(st.st_ino).second)
+			bytes += static_cast<unsigned long long>(st.st_blocks) * 512;
+	}
+	return bytes;
+}
+
+static size_t countWrong(const std::vector<ShrubberyCreationForm*>& forms)
+{
+	const std::string art(ShrubberyCreationForm::getArt(), ShrubberyCreationForm::getArtSize());
+	size_t wrong = 0;
+
+	for (size_t i = 0; i < forms.size(); i++)
+	{
+		std::ifstream file((forms[i]->getTarget() + "_shrubbery").c_str());
+		std::ostringstream content;
+		content << file.rdbuf();
+		if (content.str() != art)
+			wrong++;
+	}
+	return wrong;
+}
+
+static std::string methods(const DedupShrubberyOutput& output)
+{
+	std::ostringstream out;
+
+	for (int m = 0; m < DedupShrubberyOutput::METHOD_COUNT; m++)
+	{
+		DedupShrubberyOutput::Method method = static_cast<DedupShrubberyOutput::Method>(m);
+		if (output.count(method) == 0)
+			continue;
+		if (out.tellp() > 0)
+			out << ", ";
+		out << DedupShrubberyOutput::methodName(method) << " " << output.count(method);
+	}
+	return out.str();
+}
+
+// mode 0: plain tryExecute, 1: dedup, 2: dedup with hard links,
+// 3: dedup with copy_file_range behind the clone
+static void run(const std::string& dir, size_t count)
+{
+	static const char* labels[4] = { "  tryExecute, one write each", "  dedup", "  dedup, hard links",
+		"  dedup, copy_file_range" };
+	Bureaucrat boss("Boss", 1);
+	std::vector<ShrubberyCreationForm*> forms(count);
+	std::vector<FormExecutor::Result> results(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		std::ostringstream target;
+		target << dir << "/t" << i;
+		forms[i] = new ShrubberyCreationForm(target.str());
+		forms[i]->trySign(boss);
+	}
+
+	for (int mode = 0; mode < 4; mode++)
+	{
+		double best = 0;
+		unsigned long long usage = 0;
+		size_t wrong = 0;
+		std::string used;
+		for (int round = 0; round < 5; round++)
+		{
+			// Start each pass with nothing left to write back, or ext4
+			// charges the previous pass to this one
+			removeAll(forms);
+			sync();
+			DedupShrubberyOutput output(mode == 2);
+			if (mode == 3)
+				output.enable(DedupShrubberyOutput::COPY_RANGE);
+			double start = benchNow();
+			if (mode == 0)
+				for (size_t i = 0; i < count; i++)
+					forms[i]->tryExecute(boss);
+			else
+				output.execute(&forms[0], count, boss, &results[0]);
+			double elapsed = benchNow() - start;
+			if (round == 0 || elapsed < best)
+				best = elapsed;
+			if (round == 0)
+			{
+				usage = diskUsage(forms);
+				wrong = countWrong(forms);
+				used = methods(output);
+			}
+		}
+		benchReport(labels[mode], best, count);
+		std::cout << "      disk " << usage / 1024 << " KiB";
+		if (mode != 0)
+			std::cout << ", " << (used.empty() ? "nothing" : used);
+		std::cout << ", " << wrong << " wrong files" << std::endl;
+	}
+
+	removeAll(forms);
+	for (size_t i = 0; i < count; i++)
+		delete forms[i];
+}
+
+void benchDedup()
+{
+	const size_t count = 20000;
+	int savedTrace = getTraceLevel();
+
+	setTraceLevel(TRACE_NONE);
+	benchHeader("Dedup shrubbery output (20000 files, best of 5)");
+	static const char* dirs[2] = { "/dev/shm/bench_dedup", "/tmp/bench_dedup" };
+	for (int d = 0; d < 2; d++)
+	{
+		if (mkdir(dirs[d], 0755) != 0)
+			continue;
+		std::cout << "  in " << dirs[d] << std::endl;
+		run(dirs[d], count);
+		rmdir(dirs[d]);
+	}
+	setTraceLevel(savedTrace);
+}
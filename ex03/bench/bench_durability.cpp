@@ -0,0 +1,202 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_durability.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/30 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/30 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../Durability.hpp"
+#include "../ShrubberyOutput.hpp"
+#include "../Trace.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+struct Writer
+{
+	const std::vector<ShrubberyCreationForm*>*	forms;
+	const Bureaucrat*	boss;
+	size_t				begin;
+	size_t				end;
+	double*				latencies;
+};
+
+// Each form timed on its own: the file write plus whatever the policy adds
+static void* writerMain(void* arg)
+{
+	Writer* w = static_cast<Writer*>(arg);
+
+	for (size_t i = w->begin; i < w->end; i++)
+	{
+		double start = benchNow();
+		(*w->forms)[i]->tryExecute(*w->boss);
+		w->latencies[i] = benchNow() - start;
+	}
+	return NULL;
+}
+
+static void removeAll(const std::vector<ShrubberyCreationForm*>& forms)
+{
+	for (size_t i = 0; i < forms.size(); i++)
+		std::remove((forms[i]->getTarget() + "_shrubbery").c_str());
+}
+
+static void printLatency(std::vector<double>& latencies)
+{
+	std::sort(latencies.begin(), latencies.end());
+	std::cout << std::fixed << std::setprecision(1)
+			  << "      latency p50 " << latencies[latencies.size() / 2] / 1000 << " us"
+			  << ", p99 " << latencies[latencies.size() * 99 / 100] / 1000 << " us"
+			  << ", max " << latencies.back() / 1000 << " us" << std::endl;
+}
+
+static void runThreads(const std::vector<ShrubberyCreationForm*>& forms, int threads,
+	const std::string& label)
+{
+	Bureaucrat boss("Boss", 1);
+	std::vector<double> latencies(forms.size());
+	std::vector<pthread_t> ids(threads);
+	std::vector<Writer> writers(threads);
+
+	double start = benchNow();
+	for (int t = 0; t < threads; t++)
+	{
+		writers[t].forms = &forms;
+		writers[t].boss = &boss;
+		writers[t].begin = forms.size() * t / threads;
+		writers[t].end = forms.size() * (t + 1) / threads;
+		writers[t].latencies = &latencies[0];
+		pthread_create(&ids[t], NULL, &writerMain, &writers[t]);
+	}
+	for (int t = 0; t < threads; t++)
+		pthread_join(ids[t], NULL);
+	double elapsed = benchNow() - start;
+
+	benchReport(label, elapsed, static_cast<long>(forms.size()));
+	printLatency(latencies);
+}
+
+// The whole batch through one ShrubberyOutput::execute: one latency
+static void runBatch(const std::vector<ShrubberyCreationForm*>& forms, ShrubberyOutput& output,
+	const std::string& label)
+{
+	Bureaucrat boss("Boss", 1);
+	std::vector<FormExecutor::Result> results(forms.size());
+
+	double start = benchNow();
+	size_t written = output.execute(&forms[0], forms.size(), boss, &results[0]);
+	double elapsed = benchNow() - start;
+	benchReport(label, elapsed, static_cast<long>(forms.size()));
+	if (written != forms.size())
+		std::cout << "      " << forms.size() - written << " files FAILED" << std::endl;
+}
+
+static std::vector<ShrubberyCreationForm*> makeForms(const std::string& dir, int run, size_t count)
+{
+	Bureaucrat boss("Boss", 1);
+	std::vector<ShrubberyCreationForm*> forms(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		std::ostringstream target;
+		target << dir << "/r" << run << "_t" << i;
+		forms[i] = new ShrubberyCreationForm(target.str());
+		forms[i]->trySign(boss);
+	}
+	return forms;
+}
+
+// Fresh names for every run, and nothing left to write back or discard
+// from the previous one when the clock starts
+static void dropForms(std::vector<ShrubberyCreationForm*>& forms)
+{
+	removeAll(forms);
+	for (size_t i = 0; i < forms.size(); i++)
+		delete forms[i];
+	forms.clear();
+	sync();
+}
+
+// A file that cannot be written or synced fails the form, with the cause
+static bool failsWith(const std::string& target, const char* link, const char* cause)
+{
+	Bureaucrat boss("Boss", 1);
+	ShrubberyCreationForm form(target);
+	std::string name = target + "_shrubbery";
+	FormExecutor::Result result;
+
+	if (link != NULL)
+		symlink(link, name.c_str());
+	form.trySign(boss);
+	FormExecutor::run(form, boss, result);
+	if (link != NULL)
+		unlink(name.c_str());
+	return result.actionFailed && result.error.find(cause) != std::string::npos;
+}
+
+static void checkFailures()
+{
+	setDurability(DURABILITY_FSYNC);
+	bool open = failsWith("/nonexistent/dir/x", NULL, std::strerror(ENOENT));
+	bool write = failsWith("/tmp/bench_durability_full", "/dev/full", std::strerror(ENOSPC));
+	bool fsync = failsWith("/tmp/bench_durability_null", "/dev/null", std::strerror(EINVAL));
+	std::cout << "  failed open, write and fsync fail the form: "
+			  << (open && write && fsync ? "yes" : "NO") << std::endl;
+}
+
+void benchDurability()
+{
+	const size_t count = 2000;
+	const int threads = 16;
+	int savedTrace = getTraceLevel();
+	DurabilityPolicy saved = getDurability();
+	static const DurabilityMode modes[3] = { DURABILITY_NONE, DURABILITY_FSYNC, DURABILITY_GROUP };
+
+	setTraceLevel(TRACE_NONE);
+	std::ostringstream title;
+	title << "Durability policies (" << count << " files, " << threads
+		  << " threads; group = " << threads << " files or 5 ms)";
+	benchHeader(title.str());
+
+	static const char* dirs[2] = { "/dev/shm/bench_durability", "/tmp/bench_durability" };
+	for (int d = 0; d < 2; d++)
+	{
+		if (mkdir(dirs[d], 0755) != 0)
+			continue;
+		std::cout << "  in " << dirs[d] << std::endl;
+		sync();
+		for (int m = 0; m < 3; m++)
+		{
+			std::vector<ShrubberyCreationForm*> forms = makeForms(dirs[d], m, count);
+			setDurability(modes[m], threads, 5);
+			runThreads(forms, threads, std::string("  tryExecute, ") + durabilityName(modes[m]));
+			dropForms(forms);
+		}
+		PoolShrubberyOutput pool(4);
+		for (int m = 0; m < 3; m++)
+		{
+			std::vector<ShrubberyCreationForm*> forms = makeForms(dirs[d], m + 3, count);
+			setDurability(modes[m], threads, 5);
+			runBatch(forms, pool, std::string("  pool batch, ") + durabilityName(modes[m]));
+			dropForms(forms);
+		}
+		rmdir(dirs[d]);
+	}
+	checkFailures();
+	setDurability(saved.mode, saved.groupFiles, saved.groupMs);
+	setTraceLevel(savedTrace);
+}
@@ -0,0 +1,79 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_executor.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/17 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/17 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../FormExecutor.hpp"
+#include "../ShrubberyCreationForm.hpp"
+#include "../Trace.hpp"
+#include <sstream>
+#include <vector>
+#include <cstdio>
+#include <unistd.h>
+#include <sys/stat.h>
+
+static const char* g_dir = "/tmp/bench_executor";
+
+// Shrubbery files are the expensive case: one open/write/close each
+static void run(long maxThreads)
+{
+	const size_t jobs = 4000;
+
+	Bureaucrat boss("Boss", 1);
+	std::vector<ShrubberyCreationForm*> forms(jobs);
+	for (size_t i = 0; i < jobs; i++)
+	{
+		std::ostringstream target;
+		target << g_dir << "/t" << i;
+		forms[i] = new ShrubberyCreationForm(target.str());
+		forms[i]->trySign(boss);
+	}
+
+	// Create the files once so every run below only rewrites them
+	for (size_t i = 0; i < jobs; i++)
+		forms[i]->tryExecute(boss);
+
+	benchHeader("Shrubbery executions on a FormExecutor (4000 jobs)");
+	double start = benchNow();
+	for (size_t i = 0; i < jobs; i++)
+		forms[i]->tryExecute(boss);
+	benchReport("caller thread only", benchNow() - start, jobs);
+
+	for (long threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		FormExecutor executor(static_cast<int>(threads));
+		start = benchNow();
+		for (size_t i = 0; i < jobs; i++)
+			executor.submit(*forms[i], boss);
+		executor.wait();
+		std::ostringstream label;
+		label << threads << " worker thread(s)";
+		benchReport(label.str(), benchNow() - start, jobs);
+	}
+
+	for (size_t i = 0; i < jobs; i++)
+	{
+		std::remove((forms[i]->getTarget() + "_shrubbery").c_str());
+		delete forms[i];
+	}
+}
+
+void benchExecutor()
+{
+	int savedTrace = getTraceLevel();
+	long cores = sysconf(_SC_NPROCESSORS_ONLN);
+
+	setTraceLevel(TRACE_NONE);
+	mkdir(g_dir, 0755);
+	run(cores < 4 ? 4 : cores);
+	rmdir(g_dir);
+	setTraceLevel(savedTrace);
+}
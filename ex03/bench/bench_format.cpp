@@ -0,0 +1,227 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_format.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/12/03 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/12/03 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../ReportFormat.hpp"
+#include "../ShrubberyCreationForm.hpp"
+#include "../RobotomyRequestForm.hpp"
+#include "../PresidentialPardonForm.hpp"
+#include "../Trace.hpp"
+#include <climits>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+// Any grades, for the comparison against operator<<
+class GradeForm : public AForm
+{
+public:
+	GradeForm(const std::string& name, int sign, int execute)
+		: AForm(name, "t", sign, execute) {}
+
+protected:
+	void executeAction() const {}
+};
+
+// Takes whatever ReportBuffer flushes and drops it
+class DiscardBuffer : public std::streambuf
+{
+protected:
+	int				overflow(int c) { return c; }
+	std::streamsize	xsputn(const char*, std::streamsize n) { return n; }
+};
+
+struct FormatContext
+{
+	std::vector<AForm*>			forms;
+	std::vector<Bureaucrat*>	people;
+	char						line[256];
+	size_t						total;
+	ReportBuffer*				report;
+};
+
+template <typename T>
+static std::string streamed(const T& item)
+{
+	std::ostringstream out;
+
+	out << item;
+	return out.str();
+}
+
+template <typename T>
+static bool sameText(const T& item, size_t (*format)(char*, size_t, const T&))
+{
+	std::string expected = streamed(item);
+	std::vector<char> line(expected.size() + 1);
+	size_t length = format(&line[0], line.size(), item);
+
+	// Too small a buffer: the length is still right and nothing spills
+	char small[8] = { 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x' };
+	size_t again = format(small, 4, item);
+	return length == expected.size() && expected.compare(0, length, &line[0], length) == 0
+		&& again == length && small[4] == 'x';
+}
+
+static size_t validate(const FormatContext& c)
+{
+	size_t wrong = 0;
+
+	for (size_t i = 0; i < c.forms.size(); i++)
+		wrong += !sameText<AForm>(*c.forms[i], &formatForm);
+	for (size_t i = 0; i < c.people.size(); i++)
+		wrong += !sameText<Bureaucrat>(*c.people[i], &formatBureaucrat);
+
+	GradeForm odd(std::string(300, 'n'), 1, 150);	// longer than the line
+	wrong += !sameText<AForm>(odd, &formatForm);
+	char digits[16];
+	int values[5] = { 0, -1, 7, INT_MAX, INT_MIN };
+	for (int v = 0; v < 5; v++)
+	{
+		size_t length = formatInt(digits, sizeof(digits), values[v]);
+		wrong += streamed(values[v]) != std::string(digits, length);
+	}
+
+	// Small buffer, so lines hit the flush and the operator<< fallback
+	std::ostringstream expected;
+	std::ostringstream got;
+	{
+		ReportBuffer report(got, 64);
+		for (size_t i = 0; i < c.forms.size(); i++)
+		{
+			report.addForm(*c.forms[i]);
+			expected << *c.forms[i] << '\n';
+		}
+		for (size_t i = 0; i < c.people.size(); i++)
+		{
+			report.addBureaucrat(*c.people[i]);
+			expected << *c.people[i] << '\n';
+		}
+		report.addForm(odd);
+		expected << odd << '\n';
+	}
+	wrong += got.str() != expected.str();
+	return wrong;
+}
+
+static void streamPerLineBody(void* ctx, long iterations)
+{
+	FormatContext& c = *static_cast<FormatContext*>(ctx);
+
+	for (long i = 0; i < iterations; i++)
+	{
+		std::ostringstream out;
+		if (i & 1)
+			out << *c.people[i % c.people.size()];
+		else
+			out << *c.forms[i % c.forms.size()];
+		c.total += out.str().size();
+	}
+}
+
+static void streamSharedBody(void* ctx, long iterations)
+{
+	FormatContext& c = *static_cast<FormatContext*>(ctx);
+	std::ostringstream out;
+
+	for (long i = 0; i < iterations; i++)
+	{
+		if (i & 1)
+			out << *c.people[i % c.people.size()] << '\n';
+		else
+			out << *c.forms[i % c.forms.size()] << '\n';
+		if ((i & 1023) == 1023)
+		{
+			c.total += out.tellp();
+			out.seekp(0);
+		}
+	}
+}
+
+static void formatBody(void* ctx, long iterations)
+{
+	FormatContext& c = *static_cast<FormatContext*>(ctx);
+
+	for (long i = 0; i < iterations; i++)
+	{
+		if (i & 1)
+			c.total += formatBureaucrat(c.line, sizeof(c.line), *c.people[i % c.people.size()]);
+		else
+			c.total += formatForm(c.line, sizeof(c.line), *c.forms[i % c.forms.size()]);
+	}
+	benchSink(c.line);
+}
+
+static void reportBody(void* ctx, long iterations)
+{
+	FormatContext& c = *static_cast<FormatContext*>(ctx);
+
+	for (long i = 0; i < iterations; i++)
+	{
+		if (i & 1)
+			c.report->addBureaucrat(*c.people[i % c.people.size()]);
+		else
+			c.report->addForm(*c.forms[i % c.forms.size()]);
+	}
+	c.report->flush();
+}
+
+void benchFormat()
+{
+	int savedTrace = getTraceLevel();
+	FormatContext c;
+	DiscardBuffer discard;
+	std::ostream sink(&discard);
+
+	setTraceLevel(TRACE_NONE);
+	{
+		Bureaucrat boss("Boss", 1);
+		for (int i = 0; i < 64; i++)
+		{
+			std::ostringstream target;
+			target << "target" << i;
+			if (i % 3 == 0)
+				c.forms.push_back(new ShrubberyCreationForm(target.str()));
+			else if (i % 3 == 1)
+				c.forms.push_back(new RobotomyRequestForm(target.str()));
+			else
+				c.forms.push_back(new PresidentialPardonForm(target.str()));
+			if (i % 2 == 0)
+				c.forms.back()->trySign(boss);
+		}
+		for (int grade = 1; grade <= 150; grade++)
+		{
+			std::ostringstream name;
+			name << (grade % 2 ? "Clerk " : "A rather long bureaucrat name ") << grade;
+			c.people.push_back(new Bureaucrat(name.str(), grade));
+			c.forms.push_back(new GradeForm("Grade Form", grade, 151 - grade));
+		}
+	}
+	c.total = 0;
+	c.report = new ReportBuffer(sink);
+
+	benchHeader("Report lines, half forms and half bureaucrats (best of 5)");
+	std::cout << "  " << c.forms.size() + c.people.size() + 6
+			  << " lines checked against operator<<: " << validate(c) << " differ" << std::endl;
+	benchRun("  operator<<, ostringstream per line", &streamPerLineBody, &c, 500000);
+	benchRun("  operator<<, one ostringstream", &streamSharedBody, &c, 500000);
+	benchRun("  formatForm/formatBureaucrat", &formatBody, &c, 500000);
+	benchRun("  ReportBuffer (64 KiB)", &reportBody, &c, 500000);
+	benchSink(&c.total);
+
+	delete c.report;
+	for (size_t i = 0; i < c.forms.size(); i++)
+		delete c.forms[i];
+	for (size_t i = 0; i < c.people.size(); i++)
+		delete c.people[i];
+	setTraceLevel(savedTrace);
+}
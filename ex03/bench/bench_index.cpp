@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_index.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/22 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/22 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../FormIndex.hpp"
+#include "../Bureaucrat.hpp"
+#include "../Trace.hpp"
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+// Arbitrary grades and an action with no side effects
+class PendingForm : public AForm
+{
+public:
+	PendingForm(int sign, int execute) : AForm("Pending", "t", sign, execute) {}
+
+protected:
+	void executeAction() const {}
+};
+
+static unsigned int g_seed = 4242;
+
+static int randomGrade()
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return static_cast<int>((g_seed >> 16) % 150) + 1;
+}
+
+// What a scan over every form reports for one grade
+static size_t scanSignable(const std::vector<PendingForm*>& forms, int grade)
+{
+	size_t count = 0;
+
+	for (size_t i = 0; i < forms.size(); i++)
+		count += !forms[i]->isFormSigned() && grade <= forms[i]->getGradeTosign();
+	return count;
+}
+
+// Both queries at every grade against a scan, executed forms tracked aside
+static size_t validate(const std::vector<PendingForm*>& forms, const std::vector<bool>& executed,
+	const FormIndex& index)
+{
+	std::vector<size_t> ids;
+	size_t mismatches = 0;
+
+	for (int grade = 1; grade <= 150; grade++)
+	{
+		size_t sign = 0;
+		size_t execute = 0;
+		for (size_t i = 0; i < forms.size(); i++)
+		{
+			if (!forms[i]->isFormSigned())
+				sign += grade <= forms[i]->getGradeTosign();
+			else if (!executed[i])
+				execute += grade <= forms[i]->getGradeToExecute();
+		}
+		index.signable(grade, ids);
+		mismatches += ids.size() != sign;
+		for (size_t n = 0; n < ids.size(); n++)
+			mismatches += forms[ids[n]]->isFormSigned()
+				|| index.form(ids[n]).getGradeTosign() < grade;
+		index.executable(grade, ids);
+		mismatches += ids.size() != execute;
+	}
+	return mismatches;
+}
+
+void benchIndex()
+{
+	const size_t count = 200000;
+	int savedTrace = getTraceLevel();
+
+	setTraceLevel(TRACE_NONE);
+	benchHeader("Pending forms by grade (200000 forms)");
+	{
+		std::vector<PendingForm*> forms(count);
+		std::vector<bool> executed(count, false);
+		FormIndex index;
+		for (size_t i = 0; i < count; i++)
+		{
+			forms[i] = new PendingForm(randomGrade(), randomGrade());
+			index.add(*forms[i]);
+		}
+
+		// Churn: sign and execute through the index with random grades
+		for (size_t n = 0; n < count; n++)
+		{
+			size_t id = (g_seed = g_seed * 1103515245 + 12345) % count;
+			Bureaucrat clerk("Clerk", randomGrade());
+			if (index.state(id) == FormIndex::AWAITING_SIGNATURE)
+				index.sign(id, clerk);
+			else if (index.execute(id, clerk) == FORM_OK)
+				executed[id] = true;
+		}
+		std::cout << "  awaiting signature " << index.awaitingSignature()
+				  << ", awaiting execution " << index.awaitingExecution()
+				  << ", mismatches against a scan: "
+				  << validate(forms, executed, index) << std::endl;
+
+		static const int grades[] = { 1, 75, 140, 150 };
+		std::vector<size_t> ids;
+		for (size_t g = 0; g < sizeof(grades) / sizeof(grades[0]); g++)
+		{
+			int grade = grades[g];
+			const int rounds = 50;
+			size_t total = 0;
+			std::ostringstream scanLabel;
+			std::ostringstream indexLabel;
+
+			scanLabel << "scan, signable, grade " << grade;
+			indexLabel << "FormIndex, grade " << grade
+					   << " (" << scanSignable(forms, grade) << ")";
+
+			double start = benchNow();
+			for (int r = 0; r < rounds; r++)
+				total += scanSignable(forms, grade);
+			benchReport(scanLabel.str(), benchNow() - start, rounds);
+
+			start = benchNow();
+			for (int r = 0; r < rounds; r++)
+			{
+				index.signable(grade, ids);
+				total += ids.size();
+			}
+			benchReport(indexLabel.str(), benchNow() - start, rounds);
+			benchSink(&total);
+		}
+
+		for (size_t i = 0; i < count; i++)
+			delete forms[i];
+	}
+	setTraceLevel(savedTrace);
+}
@@ -0,0 +1,64 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_main.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/10 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/20 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include <cstring>
+
+struct BenchEntry
+{
+	const char*	name;
+	void		(*run)();
+};
+
+static const BenchEntry g_benches[] = {
+	{ "core", &benchCore },
+	{ "registry", &benchRegistry },
+	{ "arena", &benchArena },
+	{ "batch", &benchBatch },
+	{ "trace", &benchTrace },
+	{ "audit", &benchAudit },
+	{ "rejection", &benchRejection },
+	{ "executor", &benchExecutor },
+	{ "signing", &benchSigning },
+	{ "stealing", &benchStealing },
+	{ "table", &benchTable },
+	{ "index", &benchIndex },
+	{ "roster", &benchRoster },
+	{ "pipeline", &benchPipeline },
+	{ "random", &benchRandom },
+	{ "robotomy", &benchRobotomyBatch },
+	{ "shrubbery", &benchShrubbery },
+	{ "output", &benchOutput },
+	{ "archive", &benchArchive },
+	{ "dedup", &benchDedup },
+	{ "durability", &benchDurability },
+	{ "root", &benchRoot },
+	{ "codec", &benchCodec },
+	{ "format", &benchFormat }
+};
+
+// ./bench_bureaucrat [name...] runs only the named groups
+int main(int argc, char** argv)
+{
+	const size_t count = sizeof(g_benches) / sizeof(g_benches[0]);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		bool selected = (argc < 2);
+		for (int a = 1; a < argc; a++)
+			if (std::strcmp(argv[a], g_benches[i].name) == 0)
+				selected = true;
+		if (selected)
+			g_benches[i].run();
+	}
+	return benchFailed() ? 1 : 0;
+}
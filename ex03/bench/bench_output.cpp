@@ -0,0 +1,141 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_output.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/27 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/27 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../ShrubberyOutput.hpp"
+#include "../Trace.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <unistd.h>
+#include <sys/stat.h>
+
+static void removeAll(const std::vector<ShrubberyCreationForm*>& forms)
+{
+	for (size_t i = 0; i < forms.size(); i++)
+		std::remove((forms[i]->getTarget() + "_shrubbery").c_str());
+}
+
+static bool sameAsArt(const std::string& filename)
+{
+	std::ifstream file(filename.c_str());
+	std::ostringstream content;
+
+	content << file.rdbuf();
+	return content.str() == std::string(ShrubberyCreationForm::getArt(),
+		ShrubberyCreationForm::getArtSize());
+}
+
+// Good files, a refused form and a missing directory, through one backend
+static void check(ShrubberyOutput& output, const std::string& dir)
+{
+	Bureaucrat boss("Boss", 1);
+	Bureaucrat intern("Intern", 150);
+	ShrubberyCreationForm good(dir + "/check");
+	ShrubberyCreationForm lost(dir + "/missing/check");
+	ShrubberyCreationForm refused(dir + "/refused");
+	const ShrubberyCreationForm* forms[3] = { &good, &lost, &refused };
+	FormExecutor::Result results[3];
+
+	good.trySign(boss);
+	lost.trySign(boss);
+	output.execute(forms, 3, boss, results);
+	bool fine = results[0].status == FORM_OK && !results[0].actionFailed
+		&& sameAsArt(good.getTarget() + "_shrubbery")
+		&& results[1].actionFailed && results[2].status == FORM_NOT_SIGNED;
+	std::cout << "  " << output.name() << ": file bytes, missing directory and refused form "
+			  << (fine ? "reported correctly" : "WRONG") << std::endl;
+	if (results[1].actionFailed)
+		std::cout << "    (" << results[1].error.substr(results[1].error.rfind(':') + 2) << ")"
+				  << std::endl;
+	std::remove((good.getTarget() + "_shrubbery").c_str());
+	(void)intern;
+}
+
+static void run(const std::string& dir, size_t count, ShrubberyOutput** outputs, size_t outputCount)
+{
+	Bureaucrat boss("Boss", 1);
+	std::vector<ShrubberyCreationForm*> forms(count);
+	std::vector<FormExecutor::Result> results(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		std::ostringstream target;
+		target << dir << "/t" << i;
+		forms[i] = new ShrubberyCreationForm(target.str());
+		forms[i]->trySign(boss);
+	}
+
+	std::vector<double> best(outputCount + 1, 0);
+	for (int round = 0; round < 3; round++)
+	{
+		removeAll(forms);
+		double start = benchNow();
+		for (size_t i = 0; i < count; i++)
+			forms[i]->tryExecute(boss);
+		double elapsed = benchNow() - start;
+		if (round == 0 || elapsed < best[0])
+			best[0] = elapsed;
+
+		for (size_t o = 0; o < outputCount; o++)
+		{
+			removeAll(forms);
+			start = benchNow();
+			outputs[o]->execute(&forms[0], count, boss, &results[0]);
+			elapsed = benchNow() - start;
+			if (round == 0 || elapsed < best[o + 1])
+				best[o + 1] = elapsed;
+		}
+	}
+	benchReport("  tryExecute, one file at a time", best[0], count);
+	for (size_t o = 0; o < outputCount; o++)
+		benchReport(std::string("  ") + outputs[o]->name(), best[o + 1], count);
+
+	removeAll(forms);
+	for (size_t i = 0; i < count; i++)
+		delete forms[i];
+}
+
+void benchOutput()
+{
+	const size_t count = 20000;
+	int savedTrace = getTraceLevel();
+	ShrubberyOutput* outputs[2];
+	size_t outputCount = 0;
+
+	setTraceLevel(TRACE_NONE);
+	outputs[outputCount++] = new PoolShrubberyOutput(4);
+	if (UringShrubberyOutput* uring = UringShrubberyOutput::tryCreate())
+		outputs[outputCount++] = uring;
+
+	benchHeader("Shrubbery output backends (20000 files, best of 3)");
+	if (outputCount == 1)
+		std::cout << "  io_uring unavailable here, thread pool only" << std::endl;
+
+	static const char* dirs[2] = { "/dev/shm/bench_output", "/tmp/bench_output" };
+	for (int d = 0; d < 2; d++)
+	{
+		if (mkdir(dirs[d], 0755) != 0)
+			continue;
+		std::cout << "  in " << dirs[d] << std::endl;
+		for (size_t o = 0; o < outputCount; o++)
+			check(*outputs[o], dirs[d]);
+		run(dirs[d], count, outputs, outputCount);
+		rmdir(dirs[d]);
+	}
+
+	for (size_t o = 0; o < outputCount; o++)
+		delete outputs[o];
+	setTraceLevel(savedTrace);
+}
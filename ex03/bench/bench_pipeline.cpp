@@ -0,0 +1,109 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_pipeline.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/24 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/24 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../FormPipeline.hpp"
+#include "../Trace.hpp"
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+// A form whose action costs a fixed amount of work and prints nothing,
+// so the stages are measured and not the console
+class PaperworkForm : public AForm
+{
+public:
+	PaperworkForm(const std::string& target) : AForm("Paperwork", target, 150, 150) {}
+
+protected:
+	void executeAction() const
+	{
+		unsigned int x = getTarget().size();
+		for (int i = 0; i < 2000; i++)
+			x = x * 1664525 + 1013904223;
+		volatile unsigned int keep = x;	// benchSink is not thread-safe
+		(void)keep;
+	}
+};
+
+static AForm* createPaperwork(const std::string& target)
+{
+	return new PaperworkForm(target);
+}
+
+static void printStages(const FormPipeline& pipeline)
+{
+	for (int s = 0; s < FormPipeline::STAGE_COUNT; s++)
+	{
+		FormPipeline::Stage stage = static_cast<FormPipeline::Stage>(s);
+		FormPipeline::StageStats stats = pipeline.stats(stage);
+		double perThread = stats.busyNs / stats.threads;
+		std::cout << "    " << std::left << std::setw(8) << FormPipeline::stageName(stage)
+				  << std::right << std::setw(2) << stats.threads << " thr "
+				  << std::fixed << std::setprecision(0)
+				  << std::setw(10) << (perThread > 0 ? stats.processed * 1e9 / perThread : 0)
+				  << " forms/s busy, depth max " << std::setw(5) << stats.maxDepth
+				  << " mean " << std::setprecision(1) << std::setw(7) << stats.meanDepth
+				  << ", stalls " << stats.stalls << std::endl;
+		std::cout.unsetf(std::ios::fixed);
+	}
+}
+
+static void run(const std::vector<FormRequest>& requests, int intake, int sign, int execute)
+{
+	Bureaucrat boss("Boss", 1);
+	FormPipeline pipeline(boss, boss, intake, sign, execute, 256);
+	std::ostringstream label;
+
+	label << "pipeline " << intake << "/" << sign << "/" << execute << " threads";
+	double start = benchNow();
+	for (size_t i = 0; i < requests.size(); i++)
+		pipeline.submit(requests[i]);
+	pipeline.finish();
+	benchReport(label.str(), benchNow() - start, requests.size());
+	printStages(pipeline);
+}
+
+void benchPipeline()
+{
+	const size_t count = 100000;
+	int savedTrace = getTraceLevel();
+
+	setTraceLevel(TRACE_NONE);
+	Intern::registerForm("paperwork", &createPaperwork);
+	benchHeader("Intake -> sign -> execute (100000 forms, 1 in 50 unknown)");
+	{
+		std::vector<FormRequest> requests(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			requests[i].formName = (i % 50 == 49) ? "lost form" : "paperwork";
+			requests[i].target = "desk";
+		}
+
+		Bureaucrat boss("Boss", 1);
+		Intern intern;
+		double start = benchNow();
+		for (size_t i = 0; i < count; i++)
+		{
+			AForm* form = intern.createForm(requests[i].formName, requests[i].target);
+			if (form && form->trySign(boss) == FORM_OK)
+				form->tryExecute(boss);
+			delete form;
+		}
+		benchReport("one thread, no queues", benchNow() - start, count);
+
+		run(requests, 1, 1, 1);
+		run(requests, 1, 1, 2);
+		run(requests, 1, 1, 4);
+	}
+	setTraceLevel(savedTrace);
+}
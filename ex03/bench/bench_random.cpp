@@ -0,0 +1,190 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_random.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/25 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/25 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../RobotomyRequestForm.hpp"
+#include "../Random.hpp"
+#include "../Bureaucrat.hpp"
+#include "../Trace.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <pthread.h>
+
+struct DrawJob
+{
+	long	draws;
+	long	successes;
+};
+
+static void* drawOutcomes(void* arg)
+{
+	DrawJob* job = static_cast<DrawJob*>(arg);
+	long successes = 0;
+
+	for (long i = 0; i < job->draws; i++)
+		successes += RobotomyRequestForm::drawOutcome();
+	job->successes = successes;
+	return NULL;
+}
+
+// Wall time for threads * draws outcomes, all threads at once
+static double runThreads(int threads, long draws, long& successes)
+{
+	std::vector<pthread_t> ids(threads);
+	std::vector<DrawJob> jobs(threads);
+
+	double start = benchNow();
+	for (int t = 0; t < threads; t++)
+	{
+		jobs[t].draws = draws;
+		pthread_create(&ids[t], NULL, &drawOutcomes, &jobs[t]);
+	}
+	successes = 0;
+	for (int t = 0; t < threads; t++)
+	{
+		pthread_join(ids[t], NULL);
+		successes += jobs[t].successes;
+	}
+	return benchNow() - start;
+}
+
+// |z| under 4 for a fair coin fails about once in 16000 runs
+static void checkRate(const std::string& label, long successes, long draws)
+{
+	double z = (successes - draws / 2.0) / std::sqrt(draws / 4.0);
+
+	std::cout << "  " << std::left << std::setw(34) << label << std::right
+			  << std::fixed << std::setprecision(4)
+			  << 100.0 * successes / draws << "% success, z = "
+			  << std::setprecision(2) << z
+			  << (std::fabs(z) < 4 ? "  ok" : "  SUSPICIOUS") << std::endl;
+	std::cout.unsetf(std::ios::fixed);
+}
+
+static bool replays(unsigned long long seed)
+{
+	std::vector<bool> first(1000);
+
+	setRandomSeed(seed);
+	for (size_t i = 0; i < first.size(); i++)
+		first[i] = RobotomyRequestForm::drawOutcome();
+	setRandomSeed(seed);
+	for (size_t i = 0; i < first.size(); i++)
+		if (first[i] != RobotomyRequestForm::drawOutcome())
+			return false;
+	return true;
+}
+
+void benchRandom()
+{
+	const long draws = 4000000;
+	unsigned long long savedSeed = getRandomSeed();
+	RandomSource savedSource = RobotomyRequestForm::getRandomSource();
+
+	benchHeader("Robotomy outcomes: xoshiro256** per thread vs std::rand");
+	RobotomyRequestForm::setRandomSource(&threadRandom);
+	std::cout << "  same seed, same 1000 outcomes: "
+			  << (replays(42) ? "yes" : "NO") << std::endl;
+
+	long successes;
+	runThreads(1, draws, successes);
+	checkRate("xoshiro, 1 thread", successes, draws);
+	runThreads(4, draws, successes);
+	checkRate("xoshiro, 4 threads", successes, 4 * draws);
+	RobotomyRequestForm::setRandomSource(&stdRandom);
+	std::srand(42);
+	runThreads(1, draws, successes);
+	checkRate("std::rand, 1 thread", successes, draws);
+
+	static const RandomSource sources[2] = { &stdRandom, &threadRandom };
+	static const char* names[2] = { "std::rand", "xoshiro" };
+	for (int threads = 1; threads <= 4; threads *= 2)
+	{
+		for (int s = 0; s < 2; s++)
+		{
+			std::ostringstream label;
+			RobotomyRequestForm::setRandomSource(sources[s]);
+			label << names[s] << ", " << threads << " thread(s)";
+			benchReport(label.str(), runThreads(threads, draws, successes), threads * draws);
+		}
+	}
+	RobotomyRequestForm::setRandomSource(savedSource);
+	setRandomSeed(savedSeed);
+}
+
+static void runBatch(size_t count)
+{
+	Bureaucrat boss("Boss", 1);
+	std::vector<RobotomyRequestForm*> forms(count);
+	std::vector<unsigned char> outcomes(count);
+	size_t total = 0;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		forms[i] = new RobotomyRequestForm("Bender");
+		forms[i]->trySign(boss);
+	}
+
+	// Bad bytes or a biased rate would show here first
+	long successes = 0;
+	size_t badBytes = 0;
+	for (int round = 0; round < 40; round++)
+	{
+		RobotomyRequestForm::drawOutcomes(&outcomes[0], count);
+		for (size_t i = 0; i < count; i++)
+		{
+			successes += outcomes[i] == ROBOTOMY_SUCCEEDED;
+			badBytes += outcomes[i] > ROBOTOMY_SUCCEEDED;
+		}
+	}
+	checkRate("drawOutcomes, 40 batches", successes, 40 * static_cast<long>(count));
+	std::cout << "  bytes other than 0/1: " << badBytes << std::endl;
+
+	double start = benchNow();
+	{
+		BenchQuiet quiet;
+		for (size_t i = 0; i < count; i++)
+			forms[i]->tryExecute(boss);
+	}
+	benchReport("tryExecute each form (3 lines)", benchNow() - start, count);
+
+	start = benchNow();
+	for (size_t i = 0; i < count; i++)
+		total += RobotomyRequestForm::drawOutcome();
+	benchReport("drawOutcome each form", benchNow() - start, count);
+
+	start = benchNow();
+	RobotomyRequestForm::drawOutcomes(&outcomes[0], count);
+	benchReport("drawOutcomes, one batch", benchNow() - start, count);
+
+	start = benchNow();
+	total += RobotomyRequestForm::executeBatch(&forms[0], count, boss, &outcomes[0]);
+	benchReport("executeBatch (checks + outcomes)", benchNow() - start, count);
+	benchSink(&total);
+
+	for (size_t i = 0; i < count; i++)
+		delete forms[i];
+}
+
+void benchRobotomyBatch()
+{
+	int savedTrace = getTraceLevel();
+
+	setTraceLevel(TRACE_NONE);
+	benchHeader("Robotomy outcomes for 1000000 forms, one at a time vs batched");
+	runBatch(1000000);
+	setTraceLevel(savedTrace);
+}
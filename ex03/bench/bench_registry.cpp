@@ -0,0 +1,86 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_registry.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/10 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/10 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../FormRegistry.hpp"
+#include <sstream>
+#include <vector>
+
+static AForm* createNothing(const std::string& target)
+{
+	(void)target;
+	return NULL;
+}
+
+// What Intern::makeForm used to do on every call
+static int legacyFind(const std::string& formName)
+{
+	const std::string formNames[3] = {
+		"shrubbery creation",
+		"robotomy request",
+		"presidential pardon"
+	};
+
+	for (int i = 0; i < 3; i++)
+		if (formName == formNames[i])
+			return i;
+	return -1;
+}
+
+static void fillNames(std::vector<std::string>& names, size_t count)
+{
+	names.push_back("shrubbery creation");
+	names.push_back("robotomy request");
+	names.push_back("presidential pardon");
+	for (size_t i = names.size(); i < count; i++)
+	{
+		std::ostringstream name;
+		name << "custom form #" << i;
+		names.push_back(name.str());
+	}
+}
+
+void benchRegistry()
+{
+	const long lookups = 2000000;
+	const size_t sizes[] = { 3, 30, 300, 3000, 30000 };
+
+	benchHeader("Form name lookup");
+
+	std::vector<std::string> names;
+	fillNames(names, 3);
+
+	long found = 0;
+	double start = benchNow();
+	for (long i = 0; i < lookups; i++)
+		found += legacyFind(names[i % 3]);
+	benchReport("legacy linear scan (3 types)", benchNow() - start, lookups);
+	benchSink(&found);
+
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+	{
+		FormRegistry registry;
+		names.clear();
+		fillNames(names, sizes[s]);
+		for (size_t i = 0; i < names.size(); i++)
+			registry.add(names[i], &createNothing);
+
+		FormCreator creator = NULL;
+		start = benchNow();
+		for (long i = 0; i < lookups; i++)
+			creator = registry.find(names[i % names.size()]);
+		std::ostringstream label;
+		label << "FormRegistry::find (" << sizes[s] << " types)";
+		benchReport(label.str(), benchNow() - start, lookups);
+		benchSink(&creator);
+	}
+}
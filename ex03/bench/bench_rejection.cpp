@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_rejection.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/14 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/14 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../Bureaucrat.hpp"
+#include "../PresidentialPardonForm.hpp"
+#include "../Trace.hpp"
+#include <sstream>
+#include <vector>
+
+// Drops every outcome, so only the checks themselves are measured
+class DiscardAuditSink : public AuditSink
+{
+public:
+	void record(AuditEvent event, const std::string& bureaucrat,
+		const std::string& form, const char* reason)
+	{
+		(void)event;
+		(void)bureaucrat;
+		(void)form;
+		(void)reason;
+	}
+};
+
+// signers[i] is rejected for rejectPercent% of the entries
+static void fillSigners(std::vector<Bureaucrat*>& signers, int rejectPercent,
+	Bureaucrat& good, Bureaucrat& bad)
+{
+	for (size_t i = 0; i < signers.size(); i++)
+		signers[i] = (static_cast<int>(i % 100) < rejectPercent) ? &bad : &good;
+}
+
+static void run()
+{
+	const long iterations = 500000;
+	const int rates[] = { 0, 50, 99 };
+
+	Bureaucrat president("President", 1);
+	Bureaucrat clerk("Clerk", 150);
+	PresidentialPardonForm form("Arthur Dent");
+	std::vector<Bureaucrat*> signers(1000);
+
+	benchHeader("Sign attempts by rejection rate");
+	for (size_t r = 0; r < sizeof(rates) / sizeof(rates[0]); r++)
+	{
+		fillSigners(signers, rates[r], president, clerk);
+
+		long failures = 0;
+		double start = benchNow();
+		for (long i = 0; i < iterations; i++)
+		{
+			try
+			{
+				form.beSigned(*signers[i % signers.size()]);
+			}
+			catch (const std::exception&)
+			{
+				failures++;
+			}
+		}
+		std::ostringstream label;
+		label << "beSigned + catch, " << rates[r] << "% rejected";
+		benchReport(label.str(), benchNow() - start, iterations);
+
+		start = benchNow();
+		for (long i = 0; i < iterations; i++)
+			failures += form.trySign(*signers[i % signers.size()]) != FORM_OK;
+		label.str("");
+		label << "trySign, " << rates[r] << "% rejected";
+		benchReport(label.str(), benchNow() - start, iterations);
+
+		start = benchNow();
+		for (long i = 0; i < iterations; i++)
+			signers[i % signers.size()]->signForm(form);
+		label.str("");
+		label << "signForm, " << rates[r] << "% rejected";
+		benchReport(label.str(), benchNow() - start, iterations);
+		benchSink(&failures);
+	}
+}
+
+void benchRejection()
+{
+	int savedTrace = getTraceLevel();
+	DiscardAuditSink discard;
+
+	setTraceLevel(TRACE_NONE);
+	Bureaucrat::setAuditSink(&discard);
+	run();
+	Bureaucrat::setAuditSink(NULL);
+	setTraceLevel(savedTrace);
+}
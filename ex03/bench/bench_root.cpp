@@ -0,0 +1,240 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_root.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/12/01 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/12/01 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../OutputRoot.hpp"
+#include "../Trace.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+
+static std::string	g_dir;	// <parent>/out, picked by benchRoot
+
+static bool holdsArt(const std::string& path)
+{
+	std::ifstream file(path.c_str());
+	std::ostringstream content;
+
+	content << file.rdbuf();
+	return content.str() == std::string(ShrubberyCreationForm::getArt(),
+		ShrubberyCreationForm::getArtSize());
+}
+
+// executeAction (fsync through the shard fds), the root's own batch
+// backend and another backend following it, all through a sharded root
+static void check()
+{
+	OutputRoot root;
+	Bureaucrat boss("Boss", 1);
+	ShrubberyCreationForm single("single");
+	ShrubberyCreationForm batched("batched");
+	ShrubberyCreationForm broken("broken");
+	ShrubberyCreationForm pooled("pooled");
+	const ShrubberyCreationForm* pooledForms[1] = { &pooled };
+	FormExecutor::Result pooledResult;
+	PoolShrubberyOutput pool(2);
+	const ShrubberyCreationForm* forms[1] = { &batched };
+	FormExecutor::Result result;
+	FormExecutor::Result failed;
+	DurabilityPolicy saved = getDurability();
+
+	if (!root.open("/dev/shm/bench_root_check", 4))
+	{
+		std::cout << "  could not open /dev/shm/bench_root_check" << std::endl;
+		return;
+	}
+	single.trySign(boss);
+	batched.trySign(boss);
+	broken.trySign(boss);
+	pooled.trySign(boss);
+	symlink("/dev/full", root.pathOf("broken_shrubbery").c_str());
+	ShrubberyCreationForm::setOutputRoot(&root);
+	setDurability(DURABILITY_FSYNC);
+	single.tryExecute(boss);
+	FormExecutor::run(broken, boss, failed);
+	setDurability(saved.mode, saved.groupFiles, saved.groupMs);
+	pool.execute(pooledForms, 1, boss, &pooledResult);
+	ShrubberyCreationForm::setOutputRoot(NULL);
+	root.execute(forms, 1, boss, &result);
+
+	bool fine = holdsArt(root.pathOf("single_shrubbery")) && holdsArt(root.pathOf("batched_shrubbery"))
+		&& access("single_shrubbery", F_OK) != 0 && result.status == FORM_OK && !result.actionFailed;
+	std::cout << "  executeAction and batch through a 16-shard root: "
+			  << (fine ? "files in their shards" : "WRONG") << std::endl;
+	fine = holdsArt(root.pathOf("pooled_shrubbery")) && access("pooled_shrubbery", F_OK) != 0
+		&& !pooledResult.actionFailed;
+	std::cout << "  thread pool batch follows the installed root: "
+			  << (fine ? "yes" : "NO") << std::endl;
+	fine = failed.actionFailed && failed.error.find(std::strerror(ENOSPC)) != std::string::npos;
+	std::cout << "  failed write through the root fails the form: "
+			  << (fine ? "yes" : "NO") << std::endl;
+	root.remove("single_shrubbery");
+	root.remove("broken_shrubbery");
+	root.remove("pooled_shrubbery");
+	root.remove("batched_shrubbery");
+	for (size_t s = 0; s < root.shardCount(); s++)
+	{
+		std::ostringstream shard;
+		shard << "/dev/shm/bench_root_check/" << std::hex << s;
+		rmdir(shard.str().c_str());
+	}
+	root.close();
+	rmdir("/dev/shm/bench_root_check");
+}
+
+static void nameOf(char* buffer, size_t size, long i)
+{
+	std::snprintf(buffer, size, "t%07ld_shrubbery", i);
+}
+
+// The current way: a path from the process root for every call
+static void runPaths(long count)
+{
+	char path[128];
+	double start = benchNow();
+	long failed = 0;
+
+	for (long i = 0; i < count; i++)
+	{
+		std::snprintf(path, sizeof(path), "%s/t%07ld_shrubbery", g_dir.c_str(), i);
+		failed += !ShrubberyCreationForm::writeArt(path);
+	}
+	benchReport("    create", benchNow() - start, count);
+
+	start = benchNow();
+	for (long i = 0; i < count; i++)
+	{
+		std::snprintf(path, sizeof(path), "%s/t%07ld_shrubbery", g_dir.c_str(), i);
+		int fd = open(path, O_RDONLY | O_CLOEXEC);
+		failed += fd < 0;
+		close(fd);
+	}
+	benchReport("    reopen", benchNow() - start, count);
+
+	start = benchNow();
+	for (long i = 0; i < count; i++)
+	{
+		std::snprintf(path, sizeof(path), "%s/t%07ld_shrubbery", g_dir.c_str(), i);
+		failed += unlink(path) != 0;
+	}
+	benchReport("    remove", benchNow() - start, count);
+	if (failed)
+		std::cout << "    " << failed << " operations FAILED" << std::endl;
+	rmdir(g_dir.c_str());
+}
+
+static void runRoot(long count, unsigned int shardBits)
+{
+	OutputRoot root;
+	char name[64];
+	long failed = 0;
+
+	if (!root.open(g_dir, shardBits))
+	{
+		std::cout << "    could not open " << g_dir << std::endl;
+		return;
+	}
+	double start = benchNow();
+	for (long i = 0; i < count; i++)
+	{
+		nameOf(name, sizeof(name), i);
+		failed += !root.writeArt(name);
+	}
+	benchReport("    create", benchNow() - start, count);
+
+	start = benchNow();
+	for (long i = 0; i < count; i++)
+	{
+		nameOf(name, sizeof(name), i);
+		int fd = root.openFile(name, O_RDONLY);
+		failed += fd < 0;
+		close(fd);
+	}
+	benchReport("    reopen", benchNow() - start, count);
+
+	start = benchNow();
+	for (long i = 0; i < count; i++)
+	{
+		nameOf(name, sizeof(name), i);
+		failed += !root.remove(name);
+	}
+	benchReport("    remove", benchNow() - start, count);
+	if (failed)
+		std::cout << "    " << failed << " operations FAILED" << std::endl;
+
+	for (size_t s = 0; s < root.shardCount(); s++)
+	{
+		std::ostringstream shard;
+		shard << g_dir << "/" << std::hex;
+		shard.width((shardBits + 3) / 4);
+		shard.fill('0');
+		shard << s;
+		rmdir(shard.str().c_str());
+	}
+	root.close();
+	rmdir(g_dir.c_str());
+}
+
+// Enough free inodes for count files and the shards
+static bool roomFor(const char* dir, long count)
+{
+	struct statvfs fs;
+
+	return statvfs(dir, &fs) == 0 && fs.f_favail >= static_cast<unsigned long>(count) + 4096;
+}
+
+// BENCH_ROOT_TARGETS overrides the 10^6 targets. They go to /dev/shm when
+// it has the inodes for them (tmpfs usually does not at 10^6), /tmp else.
+void benchRoot()
+{
+	long count = 1000000;
+	int savedTrace = getTraceLevel();
+
+	if (const char* env = std::getenv("BENCH_ROOT_TARGETS"))
+		count = std::atol(env) > 0 ? std::atol(env) : count;
+	setTraceLevel(TRACE_NONE);
+	std::string parent = roomFor("/dev/shm", count) ? "/dev/shm/bench_root" : "/tmp/bench_root";
+	g_dir = parent + "/out";
+	std::ostringstream title;
+	title << "Output root (" << count << " targets in " << g_dir << ")";
+	benchHeader(title.str());
+	check();
+
+	if (mkdir(parent.c_str(), 0755) != 0 || !roomFor(parent.c_str(), count))
+	{
+		std::cout << "  not enough inodes (or no " << parent << "), skipped" << std::endl;
+		rmdir(parent.c_str());
+		setTraceLevel(savedTrace);
+		return;
+	}
+
+	std::cout << "  paths from the process root, one directory" << std::endl;
+	mkdir(g_dir.c_str(), 0755);
+	sync();
+	runPaths(count);
+	sync();
+	std::cout << "  OutputRoot, one directory (openat)" << std::endl;
+	runRoot(count, 0);
+	sync();
+	std::cout << "  OutputRoot, 256 shards (openat)" << std::endl;
+	runRoot(count, 8);
+	rmdir(parent.c_str());
+	setTraceLevel(savedTrace);
+}
@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_roster.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/23 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/23 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../Roster.hpp"
+#include "../Trace.hpp"
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+static unsigned int g_seed = 2024;
+
+static unsigned int nextRandom()
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return g_seed >> 16;
+}
+
+static size_t scanAtLeast(const std::vector<Bureaucrat>& staff, int grade)
+{
+	size_t count = 0;
+
+	for (size_t i = 0; i < staff.size(); i++)
+		count += staff[i].getGrade() <= grade;
+	return count;
+}
+
+// Every grade against a scan, and every returned id within range
+static size_t validate(const std::vector<Bureaucrat>& staff, const Roster& roster)
+{
+	std::vector<size_t> ids;
+	size_t mismatches = 0;
+
+	for (int grade = 1; grade <= 150; grade++)
+	{
+		roster.atLeast(grade, ids);
+		mismatches += ids.size() != scanAtLeast(staff, grade);
+		mismatches += roster.countAtLeast(grade) != ids.size();
+		for (size_t n = 0; n < ids.size(); n++)
+			mismatches += roster.bureaucrat(ids[n]).getGrade() > grade;
+	}
+	return mismatches;
+}
+
+void benchRoster()
+{
+	const size_t count = 1000000;
+	int savedTrace = getTraceLevel();
+
+	setTraceLevel(TRACE_NONE);
+	benchHeader("Eligible bureaucrats (1000000 on the roster)");
+	{
+		std::vector<Bureaucrat> staff;
+		Roster roster;
+		staff.reserve(count);
+		for (size_t i = 0; i < count; i++)
+			staff.push_back(Bureaucrat("Clerk", nextRandom() % 150 + 1));
+		for (size_t i = 0; i < count; i++)
+			roster.add(staff[i]);
+
+		// Churn: random promotions and demotions, rejected ones included
+		size_t rejected = 0;
+		for (size_t n = 0; n < count; n++)
+		{
+			size_t id = nextRandom() % count;
+			try
+			{
+				if (nextRandom() & 1)
+					roster.promote(id);
+				else
+					roster.demote(id);
+			}
+			catch (const std::exception&)
+			{
+				rejected++;
+			}
+		}
+		std::cout << "  " << count << " grade changes (" << rejected
+				  << " rejected), mismatches against a scan: "
+				  << validate(staff, roster) << std::endl;
+
+		static const int grades[] = { 1, 5, 25, 72, 137 };
+		std::vector<size_t> ids;
+		for (size_t g = 0; g < sizeof(grades) / sizeof(grades[0]); g++)
+		{
+			int grade = grades[g];
+			const int rounds = 20;
+			size_t total = 0;
+			std::ostringstream scanLabel;
+			std::ostringstream rosterLabel;
+
+			scanLabel << "scan, executors for grade " << grade;
+			rosterLabel << "Roster, grade " << grade << " ("
+						<< roster.countAtLeast(grade) << ")";
+
+			double start = benchNow();
+			for (int r = 0; r < rounds; r++)
+				total += scanAtLeast(staff, grade);
+			benchReport(scanLabel.str(), benchNow() - start, rounds);
+
+			start = benchNow();
+			for (int r = 0; r < rounds; r++)
+			{
+				roster.atLeast(grade, ids);
+				total += ids.size();
+			}
+			benchReport(rosterLabel.str(), benchNow() - start, rounds);
+			benchSink(&total);
+		}
+
+		double start = benchNow();
+		for (size_t n = 0; n < count; n++)
+		{
+			size_t id = nextRandom() % count;
+			int grade = roster.bureaucrat(id).getGrade();
+			if (grade > 1)
+				roster.promote(id);
+			else
+				roster.demote(id);
+		}
+		benchReport("Roster promote/demote", benchNow() - start, count);
+	}
+	setTraceLevel(savedTrace);
+}
@@ -0,0 +1,144 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_shrubbery.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/26 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/26 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../ShrubberyCreationForm.hpp"
+#include "../Bureaucrat.hpp"
+#include "../Trace.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <unistd.h>
+#include <sys/stat.h>
+
+// tmpfs when there is one: the point is the per-file CPU and syscall
+// cost, and disk writeback made the numbers swing by 3x between runs
+static const char* g_dir = "/tmp/bench_shrubbery";
+
+// The executeAction this form had before the single-write version
+static void legacyWrite(const std::string& filename)
+{
+	std::ofstream file(filename.c_str());
+
+	if (!file.is_open())
+		return;
+	file << "       _-_\n";
+	file << "    /~~   ~~\\\n";
+	file << " /~~         ~~\\\n";
+	file << "{               }\n";
+	file << " \\  _-     -_  /\n";
+	file << "   ~  \\\\ //  ~\n";
+	file << "_- -   | | _- _\n";
+	file << "  _ -  | |   -_\n";
+	file << "      // \\\\\n";
+	file << "\n";
+	file << "       _-_\n";
+	file << "    /~~   ~~\\\n";
+	file << " /~~         ~~\\\n";
+	file << "{               }\n";
+	file << " \\  _-     -_  /\n";
+	file << "   ~  \\\\ //  ~\n";
+	file << "_- -   | | _- _\n";
+	file << "  _ -  | |   -_\n";
+	file << "      // \\\\\n";
+	file.close();
+}
+
+static std::string readFile(const std::string& filename)
+{
+	std::ifstream file(filename.c_str());
+	std::ostringstream content;
+
+	content << file.rdbuf();
+	return content.str();
+}
+
+static void removeAll(const std::vector<std::string>& files)
+{
+	for (size_t i = 0; i < files.size(); i++)
+		std::remove(files[i].c_str());
+}
+
+static void run(size_t count)
+{
+	Bureaucrat boss("Boss", 1);
+	std::vector<ShrubberyCreationForm*> forms(count);
+	std::vector<std::string> files(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		std::ostringstream target;
+		target << g_dir << "/t" << i;
+		forms[i] = new ShrubberyCreationForm(target.str());
+		forms[i]->trySign(boss);
+		files[i] = target.str() + "_shrubbery";
+	}
+
+	legacyWrite(files[0]);
+	std::string legacy = readFile(files[0]);
+	forms[0]->tryExecute(boss);
+	std::cout << "  same bytes as the ofstream version: "
+			  << (readFile(files[0]) == legacy ? "yes" : "NO")
+			  << " (" << ShrubberyCreationForm::getArtSize() << " bytes)" << std::endl;
+
+	// Every pass creates fresh files; best of five
+	double best[3] = { 0, 0, 0 };
+	for (int round = 0; round < 5; round++)
+	{
+		double elapsed[3];
+		removeAll(files);
+		double start = benchNow();
+		for (size_t i = 0; i < count; i++)
+			legacyWrite(files[i]);
+		elapsed[0] = benchNow() - start;
+
+		removeAll(files);
+		start = benchNow();
+		for (size_t i = 0; i < count; i++)
+			ShrubberyCreationForm::writeArt(files[i].c_str());
+		elapsed[1] = benchNow() - start;
+
+		removeAll(files);
+		start = benchNow();
+		for (size_t i = 0; i < count; i++)
+			forms[i]->tryExecute(boss);
+		elapsed[2] = benchNow() - start;
+
+		for (int k = 0; k < 3; k++)
+			if (round == 0 || elapsed[k] < best[k])
+				best[k] = elapsed[k];
+	}
+	benchReport("ofstream, 19 << per file", best[0], count);
+	benchReport("writeArt, open/write/close", best[1], count);
+	benchReport("tryExecute (writeArt + name)", best[2], count);
+
+	removeAll(files);
+	for (size_t i = 0; i < count; i++)
+		delete forms[i];
+}
+
+void benchShrubbery()
+{
+	int savedTrace = getTraceLevel();
+
+	setTraceLevel(TRACE_NONE);
+	if (mkdir("/dev/shm/bench_shrubbery", 0755) == 0)
+		g_dir = "/dev/shm/bench_shrubbery";
+	else
+		mkdir(g_dir, 0755);
+	benchHeader("Shrubbery files (20000 targets, ops = files)");
+	run(20000);
+	rmdir(g_dir);
+	setTraceLevel(savedTrace);
+}
@@ -0,0 +1,127 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_signing.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/18 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/18 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../AForm.hpp"
+#include "../Bureaucrat.hpp"
+#include "../Trace.hpp"
+#include <pthread.h>
+#include <iostream>
+#include <vector>
+
+// Counts its executions and checks it was signed when it runs
+class StressForm : public AForm
+{
+public:
+	mutable unsigned long	executions;
+	mutable unsigned long	unsignedRuns;
+
+	StressForm() : AForm("Stress", "nobody", 150, 150), executions(0), unsignedRuns(0) {}
+
+protected:
+	void executeAction() const
+	{
+		if (!isFormSigned())
+			__atomic_add_fetch(&unsignedRuns, 1, __ATOMIC_RELAXED);
+		__atomic_add_fetch(&executions, 1, __ATOMIC_RELAXED);
+	}
+};
+
+struct SigningRound
+{
+	std::vector<StressForm*>	forms;
+	std::vector<unsigned long>	wins;		// successful claims per form
+	const Bureaucrat*			bureaucrat;
+	int							passes;
+};
+
+// Every thread tries to claim and execute every form, in a different order
+static void* signAndExecute(void* arg)
+{
+	SigningRound& round = *static_cast<SigningRound*>(arg);
+	size_t count = round.forms.size();
+	static unsigned long seed = 0;
+	size_t offset = __atomic_fetch_add(&seed, 7, __ATOMIC_RELAXED) % count;
+
+	for (int pass = 0; pass < round.passes; pass++)
+	{
+		for (size_t n = 0; n < count; n++)
+		{
+			size_t i = (n + offset) % count;
+			round.forms[i]->tryExecute(*round.bureaucrat);
+			if (round.forms[i]->claimSignature(*round.bureaucrat) == FORM_OK)
+				__atomic_add_fetch(&round.wins[i], 1, __ATOMIC_RELAXED);
+			round.forms[i]->tryExecute(*round.bureaucrat);
+		}
+	}
+	return NULL;
+}
+
+// Many threads signing and executing the same forms at once. Also run by
+// make bench-tsan, where ThreadSanitizer checks the signed flag for races;
+// a wrong winner count or an unsigned execution fails the run.
+void benchSigning()
+{
+	const int threads = 8;
+	const int rounds = 50;
+	const size_t formsPerRound = 64;
+	int savedTrace = getTraceLevel();
+	unsigned long badWins = 0;
+	unsigned long unsignedRuns = 0;
+	int startFailures = 0;
+	long attempts = 0;
+
+	setTraceLevel(TRACE_NONE);
+	benchHeader("Concurrent signing (8 threads racing on 64 forms)");
+	{
+		Bureaucrat boss("Boss", 1);
+		double start = benchNow();
+		for (int r = 0; r < rounds; r++)
+		{
+			SigningRound round;
+			round.bureaucrat = &boss;
+			round.passes = 20;
+			round.wins.assign(formsPerRound, 0);
+			for (size_t i = 0; i < formsPerRound; i++)
+				round.forms.push_back(new StressForm());
+
+			std::vector<pthread_t> ids;
+			for (int t = 0; t < threads; t++)
+			{
+				pthread_t id;
+				if (pthread_create(&id, NULL, &signAndExecute, &round) == 0)
+					ids.push_back(id);
+			}
+			for (size_t t = 0; t < ids.size(); t++)
+				pthread_join(ids[t], NULL);
+			if (ids.size() < static_cast<size_t>(threads))
+				startFailures++;
+
+			for (size_t i = 0; i < formsPerRound; i++)
+			{
+				if (round.wins[i] != 1)
+					badWins++;
+				unsignedRuns += round.forms[i]->unsignedRuns;
+				delete round.forms[i];
+			}
+			attempts += static_cast<long>(ids.size()) * round.passes * formsPerRound;
+		}
+		benchReport("claim + 2x tryExecute", benchNow() - start, attempts);
+	}
+	std::cout << "  forms with other than one winner: " << badWins
+			  << ", executions of unsigned forms: " << unsignedRuns << std::endl;
+	if (badWins != 0 || unsignedRuns != 0)
+		benchFail("a form was signed twice, never, or executed unsigned");
+	if (startFailures != 0)
+		benchFail("not every thread started in some rounds");
+	setTraceLevel(savedTrace);
+}
@@ -0,0 +1,112 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_stealing.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/19 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/19 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../FormExecutor.hpp"
+#include "../StealingExecutor.hpp"
+#include "../ShrubberyCreationForm.hpp"
+#include "../RobotomyRequestForm.hpp"
+#include "../PresidentialPardonForm.hpp"
+#include "../Trace.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <cstdio>
+#include <unistd.h>
+#include <sys/stat.h>
+
+static const char* g_dir = "/tmp/bench_stealing";
+
+// 1 Shrubbery (file I/O) for every 4 Robotomies and 15 Pardons
+static std::vector<AForm*> makeMix(size_t count, const Bureaucrat& boss)
+{
+	std::vector<AForm*> forms;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		std::ostringstream target;
+		target << g_dir << "/t" << i;
+		if (i % 20 == 0)
+			forms.push_back(new ShrubberyCreationForm(target.str()));
+		else if (i % 5 == 0)
+			forms.push_back(new RobotomyRequestForm(target.str()));
+		else
+			forms.push_back(new PresidentialPardonForm(target.str()));
+		forms.back()->trySign(boss);
+	}
+	return forms;
+}
+
+template <typename Executor>
+static void runMix(const std::string& label, int threads,
+	const std::vector<AForm*>& forms, const Bureaucrat& boss)
+{
+	std::vector<double> latencies(forms.size());
+	double elapsed;
+	double busy;
+	std::string extra;
+	{
+		BenchQuiet quiet;
+		Executor executor(threads);
+		double start = benchNow();
+		for (size_t i = 0; i < forms.size(); i++)
+			executor.submit(*forms[i], boss);
+		executor.wait();
+		elapsed = benchNow() - start;
+		busy = executor.getBusyTime();
+		for (size_t i = 0; i < forms.size(); i++)
+			latencies[i] = executor.result(i).latencyNs;
+	}
+	benchReport(label, elapsed, static_cast<long>(forms.size()));
+
+	std::sort(latencies.begin(), latencies.end());
+	std::cout << std::fixed << std::setprecision(1)
+			  << "    latency p50 " << latencies[latencies.size() / 2] / 1000 << " us"
+			  << ", p99 " << latencies[latencies.size() * 99 / 100] / 1000 << " us"
+			  << ", max " << latencies.back() / 1000 << " us"
+			  << ", core utilization " << 100.0 * busy / (elapsed * threads) << "%"
+			  << std::endl;
+}
+
+void benchStealing()
+{
+	const size_t jobs = 20000;
+	int savedTrace = getTraceLevel();
+	long cores = sysconf(_SC_NPROCESSORS_ONLN);
+	int threads = static_cast<int>(cores < 4 ? 4 : cores);
+
+	setTraceLevel(TRACE_NONE);
+	mkdir(g_dir, 0755);
+	{
+		Bureaucrat boss("Boss", 1);
+		std::vector<AForm*> forms = makeMix(jobs, boss);
+		for (size_t i = 0; i < forms.size(); i += 20)
+			forms[i]->tryExecute(boss);	// create the files up front
+
+		std::ostringstream title;
+		title << "Skewed Shrubbery/Robotomy/Pardon mix (20000 jobs, "
+			  << threads << " threads)";
+		benchHeader(title.str());
+		runMix<FormExecutor>("shared FIFO (FormExecutor)", threads, forms, boss);
+		runMix<StealingExecutor>("work stealing (StealingExecutor)", threads, forms, boss);
+
+		for (size_t i = 0; i < forms.size(); i++)
+		{
+			if (i % 20 == 0)
+				std::remove((forms[i]->getTarget() + "_shrubbery").c_str());
+			delete forms[i];
+		}
+	}
+	rmdir(g_dir);
+	setTraceLevel(savedTrace);
+}
@@ -0,0 +1,176 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_table.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/21 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/21 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../FormTable.hpp"
+#include "../Bureaucrat.hpp"
+#include "../Trace.hpp"
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+// A form with arbitrary grades whose action does nothing, so tryExecute
+// can be used as the reference without side effects
+class GradeForm : public AForm
+{
+public:
+	GradeForm(int sign, int execute, const std::string& name = "Grade")
+		: AForm(name, "t", sign, execute) {}
+
+protected:
+	void executeAction() const {}
+};
+
+static unsigned int g_seed = 12345;
+
+static int randomGrade()
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return static_cast<int>((g_seed >> 16) % 150) + 1;
+}
+
+static bool bit(const FormTable::Mask& mask, size_t row)
+{
+	return (mask[row / 64] >> (row % 64)) & 1;
+}
+
+// Every grade 1..150 against beSigned / tryExecute on the real forms
+static size_t validate(const std::vector<GradeForm*>& forms, const FormTable& table)
+{
+	FormTable::Mask sign;
+	FormTable::Mask execute;
+	size_t mismatches = 0;
+
+	for (int grade = 1; grade <= 150; grade++)
+	{
+		Bureaucrat bureaucrat("Checker", grade);
+		table.signableMask(grade, sign);
+		table.executableMask(grade, execute);
+		for (size_t row = 0; row < forms.size(); row++)
+		{
+			GradeForm copy(*forms[row]);
+			bool canSign = true;
+			try
+			{
+				copy.beSigned(bureaucrat);
+			}
+			catch (const std::exception&)
+			{
+				canSign = false;
+			}
+			bool canExecute = forms[row]->tryExecute(bureaucrat) == FORM_OK;
+			if (bit(sign, row) != canSign || bit(execute, row) != canExecute)
+				mismatches++;
+		}
+	}
+	return mismatches;
+}
+
+// 256 distinct names keep their own ids across clear(); the 257th throws
+static bool checkTypes()
+{
+	FormTable table;
+	std::vector<std::string> names;
+	bool fine = true;
+
+	for (int round = 0; round < 2; round++)
+	{
+		for (size_t i = 0; i < FormTable::MAX_TYPES; i++)
+		{
+			if (round == 0)
+			{
+				std::ostringstream name;
+				name << "Type " << i;
+				names.push_back(name.str());
+			}
+			size_t row = table.add(GradeForm(1, 1, names[i]));
+			fine = fine && table.getTypeName(table.getTypeId(row)) == names[i];
+		}
+		table.clear();
+	}
+	try
+	{
+		table.add(GradeForm(1, 1, "One too many"));
+		fine = false;
+	}
+	catch (const FormTable::TooManyTypesException&)
+	{
+	}
+	return fine;
+}
+
+void benchTable()
+{
+	const size_t rows = 1000000;
+	const size_t checked = 2000;
+	int savedTrace = getTraceLevel();
+
+	setTraceLevel(TRACE_NONE);
+	benchHeader("Eligibility over 1000000 forms (all 150 grades)");
+	{
+		std::vector<GradeForm*> forms(rows);
+		FormTable table;
+		for (size_t i = 0; i < rows; i++)
+		{
+			forms[i] = new GradeForm(randomGrade(), randomGrade());
+			if (i % 3)
+				forms[i]->trySign(Bureaucrat("Signer", 1));
+			table.add(*forms[i]);
+		}
+
+		FormTable sample;
+		std::vector<GradeForm*> sampleForms(forms.begin(), forms.begin() + checked);
+		for (size_t i = 0; i < checked; i++)
+			sample.add(*sampleForms[i]);
+		std::cout << "  mismatches against beSigned/tryExecute on " << checked
+				  << " forms: " << validate(sampleForms, sample) << std::endl;
+		std::cout << "  256 type names kept apart, the 257th refused: "
+				  << (checkTypes() ? "yes" : "NO") << std::endl;
+
+		size_t total = 0;
+		double start = benchNow();
+		for (int grade = 1; grade <= 150; grade++)
+			for (size_t i = 0; i < rows; i++)
+				total += forms[i]->isFormSigned() && grade <= forms[i]->getGradeToExecute();
+		benchReport("AForm* scan, executable", benchNow() - start, rows * 150);
+
+		FormTable::Mask mask;
+		start = benchNow();
+		for (int grade = 1; grade <= 150; grade++)
+		{
+			table.executableMaskScalar(grade, mask);
+			total += FormTable::countBits(mask);
+		}
+		benchReport("FormTable scalar, executable", benchNow() - start, rows * 150);
+
+		start = benchNow();
+		for (int grade = 1; grade <= 150; grade++)
+		{
+			table.executableMask(grade, mask);
+			total += FormTable::countBits(mask);
+		}
+		benchReport("FormTable SIMD, executable", benchNow() - start, rows * 150);
+
+		start = benchNow();
+		for (int grade = 1; grade <= 150; grade++)
+		{
+			table.signableMask(grade, mask);
+			total += FormTable::countBits(mask);
+		}
+		benchReport("FormTable SIMD, signable", benchNow() - start, rows * 150);
+		benchSink(&total);
+
+		for (size_t i = 0; i < rows; i++)
+			delete forms[i];
+	}
+	setTraceLevel(savedTrace);
+}
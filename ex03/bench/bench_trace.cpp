@@ -0,0 +1,53 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_trace.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/12 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/12 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Bench.hpp"
+#include "../Bureaucrat.hpp"
+#include "../RobotomyRequestForm.hpp"
+#include "../Trace.hpp"
+
+// Copy + destroy one Bureaucrat and one form per iteration
+static double churn(long iterations)
+{
+	BenchQuiet quiet;
+	Bureaucrat boss("Boss", 1);
+	RobotomyRequestForm form("Bender");
+
+	double start = benchNow();
+	for (long i = 0; i < iterations; i++)
+	{
+		Bureaucrat copy(boss);
+		RobotomyRequestForm formCopy(form);
+		benchSink(&copy);
+		benchSink(&formCopy);
+	}
+	return benchNow() - start;
+}
+
+void benchTrace()
+{
+	const long iterations = 1000000;
+	int saved = getTraceLevel();
+
+#ifdef NO_TRACE
+	benchHeader("Lifecycle tracing (compiled out with TRACE=0)");
+#else
+	benchHeader("Lifecycle tracing (compiled in, output discarded)");
+#endif
+	setTraceLevel(TRACE_LIFECYCLE);
+	benchReport("copy + destroy, TRACE_LIFECYCLE", churn(iterations), iterations);
+	setTraceLevel(TRACE_COPIES);
+	benchReport("copy + destroy, TRACE_COPIES", churn(iterations), iterations);
+	setTraceLevel(TRACE_NONE);
+	benchReport("copy + destroy, TRACE_NONE", churn(iterations), iterations);
+	setTraceLevel(saved);
+}
@@ -18,6 +18,11 @@
 #include "RobotomyRequestForm.hpp"
 #include "PresidentialPardonForm.hpp"
 #include "Intern.hpp"
+#include "FormExecutor.hpp"
+#include "FormPipeline.hpp"
+#include "Trace.hpp"
+#include "Random.hpp"
+#include <vector>
 
 void printHeader(const std::string& title)
 {
@@ -403,10 +408,172 @@ void testInternMultipleForms()
 	std::cout << "✓ All forms deleted" << std::endl;
 }
 
+void testInternArena()
+{
+	printHeader("TEST 11: Intern - Forms in an Arena");
+	
+	FormArena arena(4);
+	Intern intern;
+	
+	std::cout << "\n--- Creating forms inside a 4-slot arena ---" << std::endl;
+	intern.makeForm("shrubbery creation", "meadow", arena);
+	intern.makeForm("robotomy request", "Marvin", arena);
+	intern.makeForm("presidential pardon", "Trillian", arena);
+	
+	for (size_t i = 0; i < arena.size(); i++)
+		std::cout << i + 1 << ". " << *arena[i] << std::endl;
+	
+	std::cout << "\n--- Releasing the whole batch at once ---" << std::endl;
+	arena.clear();
+	std::cout << "✓ Arena holds " << arena.size() << " forms" << std::endl;
+}
+
+void testInternBatch()
+{
+	printHeader("TEST 12: Intern - Batch Creation");
+	
+	Intern intern;
+	FormBatch batch;
+	std::vector<FormRequest> requests;
+	const char* pairs[6][2] = {
+		{ "robotomy request", "Bender" },
+		{ "shrubbery creation", "lawn" },
+		{ "coffee making", "break room" },
+		{ "robotomy request", "C3PO" },
+		{ "presidential pardon", "Zaphod" },
+		{ "shrubbery creation", "hedge" }
+	};
+	
+	for (int i = 0; i < 6; i++)
+	{
+		FormRequest request;
+		request.formName = pairs[i][0];
+		request.target = pairs[i][1];
+		requests.push_back(request);
+	}
+	
+	std::cout << "\n--- Creating 6 requests in one call ---" << std::endl;
+	size_t created = intern.makeForms(requests, batch);
+	std::cout << created << " forms created" << std::endl;
+	
+	std::cout << "\n--- Outcome per request ---" << std::endl;
+	for (size_t i = 0; i < batch.requestCount(); i++)
+		std::cout << i + 1 << ". " << requests[i].formName << " -> "
+				  << FormBatch::statusName(batch.status(i)) << std::endl;
+	
+	std::cout << "\n--- Forms grouped by type ---" << std::endl;
+	for (size_t g = 0; g < batch.groupCount(); g++)
+	{
+		const FormBatch::Group& group = batch.group(g);
+		std::cout << group.formName << ":" << std::endl;
+		for (size_t i = group.begin; i < group.end; i++)
+			std::cout << "  " << batch[i]->getTarget() << std::endl;
+	}
+	
+	std::cout << "\n--- Releasing the batch ---" << std::endl;
+}
+
+void testFormExecutor()
+{
+	printHeader("TEST 13: Executing Forms on a Thread Pool");
+	
+	try
+	{
+		Bureaucrat boss("Boss", 1);
+		ShrubberyCreationForm north("north");
+		ShrubberyCreationForm south("south");
+		ShrubberyCreationForm east("east");
+		ShrubberyCreationForm unsignedForm("west");
+		
+		boss.signForm(north);
+		boss.signForm(south);
+		boss.signForm(east);
+		
+		std::cout << "\n--- Submitting 4 executions to 2 workers ---" << std::endl;
+		FormExecutor executor(2);
+		size_t tickets[4];
+		tickets[0] = executor.submit(north, boss);
+		tickets[1] = executor.submit(south, boss);
+		tickets[2] = executor.submit(east, boss);
+		tickets[3] = executor.submit(unsignedForm, boss);
+		executor.wait();
+		
+		const char* targets[4] = { "north", "south", "east", "west" };
+		for (int i = 0; i < 4; i++)
+		{
+			const FormExecutor::Result& result = executor.result(tickets[i]);
+			std::cout << targets[i] << ": ";
+			if (result.status == FORM_OK)
+				std::cout << "executed" << std::endl;
+			else
+				std::cout << AForm::resultMessage(result.status) << std::endl;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Exception: " << e.what() << std::endl;
+	}
+}
+
+void testFormPipeline()
+{
+	printHeader("TEST 14: Intake -> Sign -> Execute Pipeline");
+	
+	try
+	{
+		Bureaucrat clerk("Clerk", 30);	// can sign everything but a pardon
+		Bureaucrat boss("Boss", 1);
+		const char* names[4] = { "shrubbery creation", "robotomy request",
+			"presidential pardon", "coffee request" };
+		const char* targets[4] = { "pipeline", "Marvin", "Arthur", "Break room" };
+		
+		FormPipeline pipeline(clerk, boss);
+		std::cout << "\n--- Submitting 4 requests, one thread per stage ---" << std::endl;
+		
+		// The stage threads would interleave their trace lines
+		int savedTrace = getTraceLevel();
+		setTraceLevel(TRACE_NONE);
+		for (int i = 0; i < 4; i++)
+		{
+			FormRequest request;
+			request.formName = names[i];
+			request.target = targets[i];
+			pipeline.submit(request);
+		}
+		pipeline.finish();
+		setTraceLevel(savedTrace);
+		
+		std::cout << "\n--- Results ---" << std::endl;
+		for (size_t i = 0; i < pipeline.jobCount(); i++)
+		{
+			const FormPipeline::Job& job = pipeline.result(i);
+			std::cout << job.request.formName << " (" << job.request.target << "): ";
+			if (job.form == NULL)
+				std::cout << "unknown form" << std::endl;
+			else if (job.signStatus != FORM_OK)
+				std::cout << "not signed, " << AForm::resultMessage(job.signStatus) << std::endl;
+			else
+				std::cout << "executed" << std::endl;
+		}
+		
+		std::cout << "\n--- Forms through each stage ---" << std::endl;
+		for (int s = 0; s < FormPipeline::STAGE_COUNT; s++)
+		{
+			FormPipeline::StageStats stats = pipeline.stats(static_cast<FormPipeline::Stage>(s));
+			std::cout << FormPipeline::stageName(static_cast<FormPipeline::Stage>(s)) << ": "
+					  << stats.processed << " in, " << stats.failed << " dropped" << std::endl;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Exception: " << e.what() << std::endl;
+	}
+}
+
 int main()
 {
 	// Seed random number generator for robotomy
-	std::srand(std::time(NULL));
+	setRandomSeed(std::time(NULL));
 	
 	std::cout << "\n";
 	std::cout << "╔════════════════════════════════════════╗" << std::endl;
@@ -427,6 +594,10 @@ int main()
 	testInternInvalid();
 	testInternWithBureaucrat();
 	testInternMultipleForms();
+	testInternArena();
+	testInternBatch();
+	testFormExecutor();
+	testFormPipeline();
 	
 	printHeader("ALL TESTS COMPLETED");
 	std::cout << "\nCheck the generated files:" << std::endl;
@@ -435,6 +606,8 @@ int main()
 	std::cout << "  - office_shrubbery" << std::endl;
 	std::cout << "  - park_shrubbery" << std::endl;
 	std::cout << "  - forest_shrubbery" << std::endl;
+	std::cout << "  - north_shrubbery, south_shrubbery, east_shrubbery" << std::endl;
+	std::cout << "  - pipeline_shrubbery" << std::endl;
 	std::cout << "\nNote: Robotomy has 50% random success/failure rate." << std::endl;
 	std::cout << std::endl;
 	
@@ -0,0 +1,69 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   shrubbery_extract.cpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: shkaruna <shkaruna@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/11/28 10:00:00 by shkaruna          #+#    #+#             */
+/*   Updated: 2025/11/28 10:00:00 by shkaruna         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../ShrubberyArchive.hpp"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+
+// shrubbery_extract <archive>           lists the names in the archive
+// shrubbery_extract <archive> <name>... writes each entry to stdout
+int main(int argc, char** argv)
+{
+	ShrubberyArchiveReader archive;
+
+	if (argc < 2)
+	{
+		std::cerr << "usage: " << argv[0] << " <archive> [name...]" << std::endl;
+		return 2;
+	}
+	if (!archive.open(argv[1]))
+	{
+		std::cerr << "Error: cannot read archive " << argv[1] << ": "
+				  << std::strerror(errno) << std::endl;
+		return 1;
+	}
+
+	if (argc == 2)
+	{
+		std::vector<std::string> names;
+		archive.names(names);
+		for (size_t i = 0; i < names.size(); i++)
+			std::cout << names[i] << std::endl;
+		return 0;
+	}
+
+	int status = 0;
+	for (int i = 2; i < argc; i++)
+	{
+		const char* data;
+		size_t size;
+		if (!archive.find(argv[i], data, size))
+		{
+			std::cerr << "Error: no entry " << argv[i] << " in " << argv[1] << std::endl;
+			status = 1;
+			continue;
+		}
+		while (size > 0)
+		{
+			ssize_t n = write(1, data, size);
+			if (n < 0 && errno == EINTR)
+				continue;
+			if (n <= 0)
+				return 1;
+			data += n;
+			size -= n;
+		}
+	}
+	return status;
+}